@@ -19,8 +19,10 @@
 #include "nuclear_bits/threading/ThreadPoolTask.hpp"
 
 #include "nuclear_bits/extension/ChronoController.hpp"
+#include "nuclear_bits/extension/FileController.hpp"
 #include "nuclear_bits/extension/IOController.hpp"
 #include "nuclear_bits/extension/NetworkController.hpp"
+#include "nuclear_bits/extension/ReactionHistogramController.hpp"
 
 namespace NUClear {
 
@@ -40,13 +42,25 @@ namespace NUClear {
             throw std::runtime_error("There is already a powerplant in existence (There should be a single PowerPlant)");
         }
 
+        // A stopped clock would never move unless we fast forward it
+        if(configuration.clockRate < 0.0 || (configuration.clockRate == 0.0 && !configuration.fastForward)) {
+            throw std::runtime_error("The clock rate must be positive, or zero when fast forwarding");
+        }
+
         // Store our static variable
         powerplant = this;
 
-        // Install the Chrono reactor
-        install<extension::ChronoController>();
+        // Take over the clock if we are not running in real time, before anything reads it
+        if(configuration.clockRate != 1.0 || configuration.fastForward) {
+            clock::set(clock::now(), configuration.clockRate);
+        }
+
+        // Install the IO reactor first as the Chrono reactor can use it for its timer
         install<extension::IOController>();
+        install<extension::ChronoController>();
         install<extension::NetworkController>();
+        install<extension::FileController>();
+        install<extension::ReactionHistogramController>();
 
         // Emit our arguments if any.
         auto args = std::make_unique<message::CommandLineArguments>();
@@ -60,6 +74,11 @@ namespace NUClear {
 
     PowerPlant::~PowerPlant() {
 
+        // Put the clock back to real time
+        if(configuration.clockRate != 1.0 || configuration.fastForward) {
+            clock::reset();
+        }
+
         // Bye bye powerplant
         powerplant = nullptr;
     }
@@ -77,6 +96,22 @@ namespace NUClear {
         tasks.push_back(std::forward<std::function<void ()>>(task));
     }
 
+    bool PowerPlant::idle() {
+        return scheduler.idle(configuration.threadCount) && mainThreadScheduler.idle(1);
+    }
+
+    void PowerPlant::onIdle(std::function<void ()>&& func) {
+
+        auto check = [this, func] {
+            if(idle()) {
+                func();
+            }
+        };
+
+        scheduler.onWait(std::function<void ()>(check));
+        mainThreadScheduler.onWait(std::function<void ()>(check));
+    }
+
     void PowerPlant::start() {
 
         // We are now running
@@ -122,6 +157,10 @@ namespace NUClear {
         scheduler.submit(std::forward<std::unique_ptr<threading::ReactionTask>>(task));
     }
 
+    void PowerPlant::submit(std::vector<std::unique_ptr<threading::ReactionTask>>&& tasks) {
+        scheduler.submit(std::forward<std::vector<std::unique_ptr<threading::ReactionTask>>>(tasks));
+    }
+
     void PowerPlant::submitMain(std::unique_ptr<threading::ReactionTask>&& task) {
         mainThreadScheduler.submit(std::forward<std::unique_ptr<threading::ReactionTask>>(task));
     }
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nuclear_bits/clock.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace NUClear {
+
+    namespace {
+
+        /**
+         * @brief The state of a virtual clock, it reads virtual + (base_clock::now() - real) * rate.
+         *
+         * @details
+         *  Writers are serialised by the mutex, while readers never lock. Instead they read the sequence number before
+         *  and after reading the state and retry if a writer changed it in between.
+         */
+        struct VirtualClock {
+            VirtualClock() : mutex(), sequence(0), real(0), virtual_(0), rate(1.0) {}
+
+            struct Snapshot {
+                clock::time_point real;
+                clock::time_point virtual_;
+                double rate;
+
+                clock::time_point now(const clock::time_point& base) const {
+                    return virtual_ + std::chrono::duration_cast<clock::duration>((base - real) * rate);
+                }
+            };
+
+            Snapshot read() const {
+                while (true) {
+                    uint64_t before = sequence.load(std::memory_order_acquire);
+
+                    // A writer is busy
+                    if (before & 1) {
+                        continue;
+                    }
+
+                    Snapshot s { clock::time_point(clock::duration(real.load(std::memory_order_relaxed)))
+                               , clock::time_point(clock::duration(virtual_.load(std::memory_order_relaxed)))
+                               , rate.load(std::memory_order_relaxed) };
+
+                    // If nothing was written while we were reading then our snapshot is good
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before) {
+                        return s;
+                    }
+                }
+            }
+
+            /// @brief replaces the state, the mutex must be held
+            void write(const Snapshot& s) {
+                sequence.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                real.store(s.real.time_since_epoch().count(), std::memory_order_relaxed);
+                virtual_.store(s.virtual_.time_since_epoch().count(), std::memory_order_relaxed);
+                rate.store(s.rate, std::memory_order_relaxed);
+
+                sequence.fetch_add(1, std::memory_order_release);
+            }
+
+            /// @brief serialises the writers
+            std::mutex mutex;
+            /// @brief incremented before and after each write, odd while a write is in progress
+            std::atomic<uint64_t> sequence;
+            std::atomic<clock::rep> real;
+            std::atomic<clock::rep> virtual_;
+            std::atomic<double> rate;
+        };
+
+        /// @brief if the clock is virtual, checked first so a real clock only pays for this load
+        std::atomic<bool> isVirtual(false);
+
+        VirtualClock& state() {
+            // Leaked so it can still be read during static destruction
+            static VirtualClock* state = new VirtualClock();
+            return *state;
+        }
+    }
+
+    constexpr bool clock::is_steady;
+
+    clock::time_point clock::now() {
+
+        if (!isVirtual.load(std::memory_order_acquire)) {
+            return base_clock::now();
+        }
+
+        return state().read().now(base_clock::now());
+    }
+
+    void clock::set(const time_point& start, double rate) {
+
+        VirtualClock& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.write({ base_clock::now(), start, rate });
+        isVirtual.store(true, std::memory_order_release);
+    }
+
+    void clock::reset() {
+
+        VirtualClock& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        isVirtual.store(false, std::memory_order_release);
+        s.write({ time_point(), time_point(), 1.0 });
+    }
+
+    void clock::advance(const duration& amount) {
+
+        if (isVirtual.load(std::memory_order_acquire)) {
+            VirtualClock& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            // Rebase the clock so the jump is not scaled by the rate
+            VirtualClock::Snapshot current = s.read();
+            time_point base = base_clock::now();
+            s.write({ base, current.now(base) + amount, current.rate });
+        }
+    }
+
+    double clock::rate() {
+
+        if (!isVirtual.load(std::memory_order_acquire)) {
+            return 1.0;
+        }
+
+        return state().read().rate;
+    }
+
+    clock::duration clock::real(const duration& amount) {
+
+        double r = rate();
+        if (r <= 0.0) {
+            return duration::max();
+        }
+        return std::chrono::duration_cast<duration>(amount / r);
+    }
+
+    clock::time_point clock::base(const time_point& time) {
+
+        if (!isVirtual.load(std::memory_order_acquire)) {
+            return time;
+        }
+
+        VirtualClock::Snapshot s = state().read();
+        if (s.rate <= 0.0) {
+            return time_point::max();
+        }
+        return s.real + std::chrono::duration_cast<duration>((time - s.virtual_) / s.rate);
+    }
+}
@@ -17,118 +17,333 @@
 
 #include "nuclear_bits/extension/ChronoController.hpp"
 
-#include <algorithm>
+#include <system_error>
 
 #include "nuclear_bits/dsl/word/Every.hpp"
+#include "nuclear_bits/dsl/word/IO.hpp"
+
+#ifdef __linux__
+    #include <sys/timerfd.h>
+    #include <unistd.h>
+#endif
 
 namespace NUClear {
     namespace extension {
 
         ChronoController::ChronoController(std::unique_ptr<NUClear::Environment> environment)
         : Reactor(std::move(environment))
-        , steps(0)
+        , timerfd(-1)
+        , steps()
+        , wheel(clock::now())
+        , configuration()
+        , snapshotStart(clock::now())
         , mutex()
         , wait() {
 
             on<Trigger<dsl::word::EveryConfiguration>>().then("Configure Every Reaction", [this] (const dsl::word::EveryConfiguration& config) {
 
-                auto item = std::find_if(std::begin(steps), std::end(steps), [&config] (const Step& item) {
-                    return item.jump == config.jump;
-                });
+                std::lock_guard<std::mutex> lock(mutex);
 
-                // If we haven't got this duration step yet
-                if(item == std::end(steps) ) {
-                    steps.push_back(Step {
-                        config.jump,
-                        clock::now(),
-                        std::vector<std::shared_ptr<threading::Reaction>>()
-                    });
-                    steps.back().reactions.push_back(std::move(config.reaction));
-                }
-                else {
-                    item->reactions.push_back(std::move(config.reaction));
-                }
+                // Make a timer for this reaction that first runs now, or at the start of its next period if aligned
+                auto step = std::make_unique<Step>(config.jump, config.reaction);
+                step->when = configuration.align ? aligned(clock::now(), step->jump) : clock::now();
+                wheel.insert(*step);
 
-                // Sort the steps
-                std::sort(std::begin(steps), std::end(steps));
+                steps[config.reaction->reactionId] = std::move(step);
 
                 // Poke the system
-                wait.notify_all();
+                poke();
+            });
+
+            on<Trigger<message::ChronoConfiguration>>().then("Configure Chrono Controller", [this] (const message::ChronoConfiguration& config) {
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                // If we are now aligning, move all our steps to the start of their next period
+                if(config.align && !configuration.align) {
+                    for(auto& step : steps) {
+                        wheel.cancel(*step.second);
+                        step.second->when = aligned(step.second->when, step.second->jump);
+                        wheel.insert(*step.second);
+                    }
+                }
+
+                configuration = config;
+
+                // Poke the system so it sleeps with the new window
+                poke();
             });
 
             on<Trigger<dsl::operation::Unbind<Every<>>>>().then("Unbind Every Reaction", [this] (const dsl::operation::Unbind<Every<>>& unbind) {
 
-                // Loop through all of our steps
-                for(auto& step : steps) {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                // If we have a step for this reaction then remove it
+                auto item = steps.find(unbind.reactionId);
+                if(item != std::end(steps)) {
+                    wheel.cancel(*item->second);
+                    steps.erase(item);
+                }
+            });
 
-                    // See if this step has the target reaction
-                    auto item = std::find_if(std::begin(step.reactions), std::end(step.reactions), [unbind] (const std::shared_ptr<threading::Reaction>& r) {
-                        return r->reactionId == unbind.reactionId;
-                    });
+            // Report the jitter of our steps alongside the reaction histograms
+            const clock::duration& period = powerplant.configuration.histogramPeriod;
+            if(period > clock::duration(0)) {
+                on<dsl::word::Every<>>(period).then("Every Jitter Snapshot", [this] {
 
-                    // If we have this item then remove it
-                    if(item != std::end(step.reactions)) {
-                        step.reactions.erase(item);
+                    // If nobody is listening leave the jitter and counters to keep accumulating until someone is
+                    if (dsl::store::TypeCallbackStore<message::EveryJitterSnapshot>::get().empty()) {
+                        return;
                     }
+
+                    auto snapshot = std::make_unique<message::EveryJitterSnapshot>();
+
+                    /* Mutex Scope */ {
+                        std::lock_guard<std::mutex> lock(mutex);
+
+                        // This snapshot covers everything since our last one
+                        snapshot->start = snapshotStart;
+                        snapshot->end = clock::now();
+                        snapshotStart = snapshot->end;
+
+                        for(auto& item : steps) {
+                            Step& step = *item.second;
+
+                            message::EveryJitterSnapshot::Every every;
+                            every.identifier = step.reaction->identifier;
+                            every.reactionId = step.reaction->reactionId;
+                            every.period     = step.jump;
+                            every.jitter     = step.jitter.snapshot(true);
+                            every.overruns   = step.overruns;
+                            every.skipped    = step.skipped;
+                            snapshot->every.push_back(std::move(every));
+
+                            step.overruns = 0;
+                            step.skipped  = 0;
+                        }
+                    }
+
+                    emit(snapshot);
+                });
+            }
+
+#ifdef __linux__
+            // Use a timerfd in the IO controller to wake us up instead of our own thread
+            // We can't tell when to fast forward from the IO thread, so that always uses our own thread
+            if(powerplant.configuration.multiplexTimers && !powerplant.configuration.fastForward) {
+
+                timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+                if(timerfd < 0) {
+                    throw std::system_error(errno, std::system_category(), "We were unable to make the timerfd for the chrono controller");
                 }
-            });
+
+                on<IO, Priority::REALTIME>(timerfd, IO::READ).then("Chrono Controller", [this] {
+
+                    // Read the expiration count to clear the timerfd
+                    uint64_t expirations;
+                    if(read(timerfd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+                        throw std::system_error(errno, std::system_category(), "There was an error reading the chrono controller timerfd");
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    auto wakeup = std::make_unique<message::ChronoWakeup>();
+                    wakeup->target = wheel.next();
+                    wakeup->wake = wakeup->target;
+
+                    // We may have been woken for a step that has since been removed or moved
+                    clock::time_point now(clock::now());
+                    if(now >= wakeup->target) {
+                        wakeup->sleepError = now - wakeup->target;
+                        wakeup->lateness = now - wakeup->target;
+
+                        expire(now);
+
+                        // Report how well we woke up if anyone wants to know
+                        if (!dsl::store::TypeCallbackStore<message::ChronoWakeup>::get().empty()) {
+                            emit(wakeup);
+                        }
+                    }
+
+                    // Set the timer for our next step
+                    poke();
+                });
+
+                return;
+            }
+#endif
 
             // When we shutdown we notify so we quit now
             on<Shutdown>().then("Shutdown Chrono Controller", [this] {
                 wait.notify_all();
             });
 
+            // If we are fast forwarding, we need to know when we have run out of work to do
+            if(powerplant.configuration.fastForward) {
+                powerplant.onIdle([this] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    wait.notify_all();
+                });
+            }
+
             on<Always, Priority::REALTIME>().then("Chrono Controller", [this] {
 
                 // Aquire the mutex lock so we can wait on it
                 std::unique_lock<std::mutex> lock(mutex);
 
                 // If we have steps to do
-                if(!steps.empty()) {
+                if(!wheel.empty()) {
 
-                    // Wait until the next event
-                    wait.wait_for(lock, steps.front().next - clock::now());
-
-                    // Get the current time
+                    auto wakeup = std::make_unique<message::ChronoWakeup>();
+                    wakeup->target = wheel.next();
                     clock::time_point now(clock::now());
 
-                    // Busy wait for the time to be right to improve accuracy
-                    while (now < steps.front().next) {
+                    // If nothing is left to do there is no point waiting, so skip straight to the next step
+                    if(now < wakeup->target && powerplant.configuration.fastForward && powerplant.idle()) {
+                        clock::advance(wakeup->target - now);
                         now = clock::now();
-                    };
+                    }
 
-                    // Check if any intervals are before now and if so execute their callbacks and add their step.
-                    for(auto& step : steps) {
-                        if((step.next - now).count() <= 0) {
-                            for(auto& reaction : step.reactions) {
-
-                                try {
-                                    // submit the reaction to the thread pool
-                                    auto task = reaction->getTask();
-                                    if(task) {
-                                        powerplant.submit(std::move(task));
-                                    }
-                                }
-                                catch(...) {
-                                }
-                            }
-                            step.next += step.jump;
+                    // Our spin window is in real time, so scale it to how fast the clock is moving
+                    double rate = clock::rate();
+                    wakeup->wake = wakeup->target - std::chrono::duration_cast<clock::duration>(configuration.spinWindow * rate);
+
+                    // Sleep until we are within our spin window of the next event
+                    if (now < wakeup->wake) {
+
+                        // A stopped clock only moves when we fast forward it, which we will be woken for
+                        if(rate > 0.0) {
+                            // Wait until an absolute time on the real clock so the time we spend here doesn't add to it
+                            wait.wait_until(lock, clock::base(wakeup->wake));
                         }
-                        // Since we are sorted, we can ignore any after this time
                         else {
-                            break;
+                            wait.wait(lock);
+                        }
+                        now = clock::now();
+
+                        // If we were poked or woke up early start again, as the next event may have changed
+                        if (now < wakeup->wake || wheel.next() != wakeup->target) {
+                            return;
                         }
+                        wakeup->sleepError = now - wakeup->wake;
+                    }
+
+                    // Busy wait for the rest of the time to improve accuracy, unlocked so we don't hold up configuration
+                    lock.unlock();
+                    while (now < wakeup->target) {
+                        now = clock::now();
                     }
+                    lock.lock();
+                    wakeup->lateness = now - wakeup->target;
 
-                    // Sort the steps
-                    std::sort(std::begin(steps), std::end(steps));
+                    // If our steps changed while we were spinning start again, as the next event may have changed
+                    if (wheel.next() != wakeup->target) {
+                        return;
+                    }
+
+                    expire(now);
+
+                    // Report how well we woke up if anyone wants to know
+                    if (!dsl::store::TypeCallbackStore<message::ChronoWakeup>::get().empty()) {
+                        emit(wakeup);
+                    }
                 }
                 // Otherwise we wait for something to happen
                 else {
                     wait.wait(lock);
                 }
             });
+        }
+
+        ChronoController::~ChronoController() {
+#ifdef __linux__
+            if(timerfd >= 0) {
+                close(timerfd);
+            }
+#endif
+        }
+
+        void ChronoController::expire(const clock::time_point& now) {
+
+            // Execute the callbacks of every step that is due and schedule their next run
+            wheel.expire(now, [this, &now] (util::TimingWheel::Timer& timer) {
+
+                Step& step = static_cast<Step&>(timer);
+
+                try {
+                    // submit the reaction to the thread pool
+                    auto task = step.reaction->getTask();
+                    if(task) {
+                        powerplant.submit(std::move(task));
+                    }
+                }
+                catch(...) {
+                }
+
+                // Record how late we were
+                step.jitter.record(now - step.when);
+
+                step.when += step.jump;
+
+                // If the next tick is already due we have overrun
+                if(step.when <= now) {
+                    ++step.overruns;
+
+                    switch(configuration.overrun) {
+                        // Run the missed ticks straight away
+                        case message::ChronoConfiguration::CATCH_UP: break;
+
+                        // Drop the missed ticks, keeping to our schedule
+                        case message::ChronoConfiguration::SKIP: {
+                            clock::rep missed = (now - step.when) / step.jump + 1;
+                            step.when += step.jump * missed;
+                            step.skipped += uint64_t(missed);
+                        } break;
+
+                        // Drop the missed ticks, and start a new schedule from now
+                        case message::ChronoConfiguration::REALIGN: {
+                            clock::time_point next = now + step.jump;
+                            step.skipped += uint64_t((next - step.when) / step.jump);
+                            step.when = configuration.align ? aligned(now + clock::duration(1), step.jump) : next;
+                        } break;
+                    }
+                }
+
+                wheel.insert(step);
+            });
+        }
+
+        clock::time_point ChronoController::aligned(const clock::time_point& time, const clock::duration& period) {
+
+            // Round up to the next whole number of periods
+            clock::duration since = time.time_since_epoch();
+            clock::rep periods = (since.count() + period.count() - 1) / period.count();
+            return clock::time_point(period * periods);
+        }
+
+        void ChronoController::poke() {
+
+#ifdef __linux__
+            if(timerfd >= 0) {
+
+                // Our timer is relative so it only needs to be scaled by how fast NUClear::clock runs, a zero time disarms it
+                itimerspec spec {};
+                if(!wheel.empty()) {
+                    auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::real(wheel.next() - clock::now()));
+                    wait = wait.count() > 0 ? wait : std::chrono::nanoseconds(1);
+
+                    spec.it_value.tv_sec  = time_t(wait.count() / std::nano::den);
+                    spec.it_value.tv_nsec = long(wait.count() % std::nano::den);
+                }
+
+                if(timerfd_settime(timerfd, 0, &spec, nullptr) < 0) {
+                    throw std::system_error(errno, std::system_category(), "There was an error setting the chrono controller timerfd");
+                }
+                return;
+            }
+#endif
 
+            wait.notify_all();
         }
     }
 }
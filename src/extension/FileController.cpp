@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nuclear_bits/extension/FileController.hpp"
+
+#include <cerrno>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace NUClear {
+    namespace extension {
+
+        constexpr size_t FileController::MAX_OPEN_FILES;
+
+        FileController::FileController(std::unique_ptr<NUClear::Environment> environment)
+        : Reactor(std::move(environment))
+        , mutex()
+        , wait()
+        , requests()
+        , fileMutex()
+        , files()
+        , uses(0) {
+
+            on<Trigger<dsl::word::emit::FileEmit>>().then("Queue File Write", [this] (const dsl::word::emit::FileEmit& emit) {
+
+                Request request;
+                request.path = emit.path;
+                request.data = emit.data;
+                request.sync = emit.sync;
+                queue(std::move(request));
+            });
+
+            on<Trigger<dsl::word::FileReadConfiguration>>().then("Queue File Read", [this] (const dsl::word::FileReadConfiguration& config) {
+
+                Request request;
+                request.path = config.path;
+                request.reaction = config.reaction;
+                queue(std::move(request));
+            });
+
+            on<Shutdown>().then("Shutdown File Controller", [this] {
+
+                // Wait for the file thread to finish what it is doing, so everything stays in order
+                std::lock_guard<std::mutex> files(fileMutex);
+
+                // Anything that arrives after this is handled straight away
+                std::vector<Request> remaining;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    shutdown = true;
+                    remaining.swap(requests);
+                }
+                wait.notify_all();
+
+                // Make sure nothing that was emitted before we shut down is lost
+                process(remaining);
+
+                // Now close everything, anything written after this opens its file again
+                this->files.clear();
+            });
+
+            on<Always>().then("File Controller", [this] {
+
+                // Wait until there is something to do
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wait.wait(lock, [this] {
+                        return shutdown || !requests.empty();
+                    });
+                }
+
+                // Take everything that is waiting while we hold the files so requests are handled in order
+                std::lock_guard<std::mutex> files(fileMutex);
+                std::vector<Request> batch;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    batch.swap(requests);
+                }
+
+                process(batch);
+            });
+        }
+
+        void FileController::queue(Request&& request) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!shutdown) {
+                    requests.push_back(std::move(request));
+                    wait.notify_one();
+                    return;
+                }
+            }
+
+            std::lock_guard<std::mutex> files(fileMutex);
+            std::vector<Request> batch(1);
+            batch.front() = std::move(request);
+            process(batch);
+        }
+
+        void FileController::process(std::vector<Request>& batch) {
+
+            // The files that were written to in this batch
+            std::vector<File*> written;
+
+            for(auto& request : batch) {
+
+                if(request.reaction) {
+
+                    // A read has to see the writes that came before it
+                    auto file = files.find(request.path);
+                    if(file != files.end()) {
+                        finish(file->second);
+                    }
+
+                    dsl::word::FileRead::Contents contents;
+                    contents.path = request.path;
+
+                    std::FILE* in = std::fopen(request.path.c_str(), "rb");
+                    if(in) {
+                        char buffer[BUFFER_SIZE];
+                        size_t bytes;
+                        while((bytes = std::fread(buffer, 1, sizeof(buffer), in)) > 0) {
+                            contents.data.insert(contents.data.end(), buffer, buffer + bytes);
+                        }
+                        if(std::ferror(in)) {
+                            contents.error = errno;
+                        }
+                        std::fclose(in);
+                    }
+                    else {
+                        contents.error = errno;
+                    }
+
+                    // Store the contents in our thread local cache
+                    dsl::word::FileRead::ThreadContentsStore::value = &contents;
+
+                    // Submit the task (which should run the get)
+                    try {
+                        auto task = request.reaction->getTask();
+                        if(task) {
+                            powerplant.submit(std::move(task));
+                        }
+                    }
+                    catch(...) {
+                    }
+
+                    // Reset our value
+                    dsl::word::FileRead::ThreadContentsStore::value = nullptr;
+                }
+                // A write goes into the buffer for its file
+                else {
+                    File& file = open(request.path);
+
+                    if(!file.written) {
+                        file.written = std::make_unique<message::FileWritten>();
+                        file.written->path = request.path;
+                        written.push_back(&file);
+                    }
+                    auto& report = *file.written;
+
+                    ++report.writes;
+                    report.synced |= request.sync;
+
+                    if(!file.handle) {
+                        if(report.error == 0) {
+                            report.error = file.error;
+                        }
+                    }
+                    else if(std::fwrite(request.data.data(), 1, request.data.size(), file.handle) != request.data.size()) {
+                        if(report.error == 0) {
+                            report.error = errno;
+                        }
+                    }
+                    else {
+                        report.bytes += request.data.size();
+                    }
+                }
+            }
+
+            // Write out everything from this batch
+            for(auto file : written) {
+                finish(*file);
+            }
+
+            // If this batch needed more files than we keep open, close the extra ones now they are written
+            if(files.size() > MAX_OPEN_FILES) {
+                evict();
+            }
+        }
+
+        FileController::File& FileController::open(const std::string& path) {
+
+            // Make room if this is a new file
+            if(files.size() >= MAX_OPEN_FILES && files.find(path) == files.end()) {
+                evict();
+            }
+
+            File& file = files[path];
+            file.used = ++uses;
+
+            // If it wasn't opened before, or it failed last time, try to open it
+            if(!file.handle) {
+                file.handle = std::fopen(path.c_str(), "ab");
+                if(file.handle) {
+                    std::setvbuf(file.handle, nullptr, _IOFBF, BUFFER_SIZE);
+                }
+                else {
+                    file.error = errno;
+                }
+            }
+
+            return file;
+        }
+
+        void FileController::evict() {
+
+            while(files.size() >= MAX_OPEN_FILES) {
+
+                // Files with writes in the current batch are still needed, so we don't close those
+                auto oldest = files.end();
+                for(auto it = files.begin(); it != files.end(); ++it) {
+                    if(!it->second.written && (oldest == files.end() || it->second.used < oldest->second.used)) {
+                        oldest = it;
+                    }
+                }
+
+                // Everything open is being written in this batch, the extra files are closed once it is done
+                if(oldest == files.end()) {
+                    return;
+                }
+
+                files.erase(oldest);
+            }
+        }
+
+        void FileController::finish(File& file) {
+
+            // Nothing has been written since the last time
+            if(!file.written) {
+                return;
+            }
+
+            auto& written = *file.written;
+
+            if(file.handle) {
+                if(std::fflush(file.handle) != 0 && written.error == 0) {
+                    written.error = errno;
+                }
+
+                if(written.synced) {
+#ifdef _WIN32
+                    if(_commit(_fileno(file.handle)) != 0 && written.error == 0) {
+#else
+                    if(fsync(fileno(file.handle)) != 0 && written.error == 0) {
+#endif
+                        written.error = errno;
+                    }
+                }
+            }
+
+            emit(std::move(file.written));
+        }
+
+    }  // namespace extension
+}  // namespace NUClear
@@ -0,0 +1,580 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// Only linux has epoll and io_uring
+#if defined(__linux__) && !defined(NUCLEAR_POLL_IO)
+
+#include "nuclear_bits/extension/IOController.hpp"
+
+#include <algorithm>
+#include <system_error>
+#include <mutex>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include "nuclear_bits/dsl/word/IO.hpp"
+
+namespace NUClear {
+    namespace extension {
+
+        IOController::IOController(std::unique_ptr<NUClear::Environment> environment)
+        : Reactor(std::move(environment))
+        , shutdown(false)
+        , shards()
+        , routeMutex()
+        , routes() {
+
+            // Try to use io_uring if we were asked to, if the kernel doesn't have it or won't let us use it we use epoll
+            bool useRing = powerplant.configuration.ioUring;
+
+            for(size_t i = 0; i < std::max(powerplant.configuration.ioThreads, size_t(1)); ++i) {
+                shards.push_back(std::make_unique<Shard>());
+                Shard& shard = *shards.back();
+
+                shard.notify = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if(shard.notify < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "We were unable to make the notification eventfd for IO");
+                }
+
+                if(useRing) {
+                    try {
+                        shard.ring = std::make_unique<util::IOUring>(256);
+                    }
+                    catch(const std::system_error&) {
+                        useRing = false;
+                    }
+                }
+
+                if(shard.ring) {
+                    // Start polling our notification eventfd, this will be submitted with our first wait
+                    arm(shard, nullptr);
+                }
+                else {
+                    shard.epoll = epoll_create1(EPOLL_CLOEXEC);
+                    if(shard.epoll < 0) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to make the epoll instance for IO");
+                    }
+
+                    // Add our notification eventfd, it is the only event without a watch
+                    epoll_event event {};
+                    event.events = EPOLLIN;
+                    event.data.ptr = nullptr;
+                    if(epoll_ctl(shard.epoll, EPOLL_CTL_ADD, shard.notify, &event) < 0) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to add the notification eventfd to epoll");
+                    }
+                }
+            }
+
+            on<Trigger<dsl::word::IOConfiguration>>().then("Configure IO Reaction", [this] (const dsl::word::IOConfiguration& config) {
+
+                // Remember where the reaction is watched so we can find it again, all of a batch goes to one shard
+                Shard* s;
+                {
+                    std::lock_guard<std::mutex> lock(routeMutex);
+                    Route& route = routes[config.reaction->reactionId];
+                    if(!route.shard) {
+                        route.shard = &shardFor(config.fd);
+                    }
+                    route.fds.push_back(config.fd);
+                    s = route.shard;
+                }
+                Shard& shard = *s;
+
+                // Lock our mutex to avoid concurrent modification
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                // Get the watch for this fd, or make a new one
+                auto& watch = shard.watches[config.fd];
+                if(!watch) {
+                    watch = std::make_unique<Watch>(config.fd);
+                }
+
+                watch->tasks.emplace_back(config.events, config.oneShot, config.batch, config.drain, config.reaction);
+
+                // Update what we are waiting for
+                update(shard, *watch);
+            });
+
+            on<Trigger<dsl::operation::Unbind<IO>>>().then("Unbind IO Reaction", [this] (const dsl::operation::Unbind<IO>& unbind) {
+
+                // Find where our reaction is watched
+                Route route;
+                {
+                    std::lock_guard<std::mutex> lock(routeMutex);
+                    auto it = routes.find(unbind.reactionId);
+                    if(it == routes.end()) {
+                        return;
+                    }
+                    route = std::move(it->second);
+                    routes.erase(it);
+                }
+                Shard& shard = *route.shard;
+
+                // Lock our mutex to avoid concurrent modification
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                for(const auto& fd : route.fds) {
+                    auto it = shard.watches.find(fd);
+                    if(it != shard.watches.end()) {
+                        auto& tasks = it->second->tasks;
+                        auto task = std::find_if(std::begin(tasks), std::end(tasks), [&unbind] (const Task& t) {
+                            return t.reaction->reactionId == unbind.reactionId;
+                        });
+
+                        if(task != std::end(tasks)) {
+                            tasks.erase(task);
+                            update(shard, *it->second);
+
+                            // If nothing is watching this fd anymore get rid of it, once we know no events point to it
+                            if(tasks.empty()) {
+                                shard.removed.push_back(std::move(it->second));
+                                shard.watches.erase(it);
+                            }
+                        }
+                    }
+                }
+            });
+
+            // Finished IO tasks tell us directly so they don't need a reaction of their own
+            IO::finished() = [this] (uint64_t reactionId) {
+                finished(reactionId);
+            };
+
+            on<Shutdown>().then("Shutdown IO Controller", [this] {
+
+                // Set shutdown to true so it won't try to wait again
+                shutdown = true;
+
+                // Wake up the IO threads
+                for(auto& shard : shards) {
+                    wake(*shard);
+                }
+            });
+
+            // Each shard gets its own IO thread
+            for(auto& s : shards) {
+                Shard* shard = s.get();
+                on<Always>().then("IO Controller", [this, shard] {
+
+                    // To make sure we don't get caught in a weird loop
+                    // shutdown keeps us out here
+                    if(!shutdown) {
+                        if(shard->ring) {
+                            waitRing(*shard);
+                        }
+                        else {
+                            waitEpoll(*shard);
+                        }
+                    }
+                });
+            }
+        }
+
+        IOController::~IOController() {
+            IO::finished() = nullptr;
+
+            for(auto& shard : shards) {
+                close(shard->notify);
+                if(shard->epoll >= 0) {
+                    close(shard->epoll);
+                }
+            }
+        }
+
+        IOController::Shard& IOController::shardFor(const fd_t& fd) {
+            return *shards[size_t(fd) % shards.size()];
+        }
+
+        void IOController::wake(Shard& shard) {
+            uint64_t val = 1;
+            if(write(shard.notify, &val, sizeof(val)) < 0) {
+                throw std::system_error(network_errno, std::system_category(), "There was an error while writing to the notification eventfd");
+            }
+        }
+
+        void IOController::waitEpoll(Shard& shard) {
+
+            // Wait for events on our file descriptors
+            int count = epoll_wait(shard.epoll, shard.events.data(), int(shard.events.size()), -1);
+
+            // Check if we had an error on our wait
+            if(count < 0) {
+                if(network_errno == EINTR) {
+                    return;
+                }
+                throw std::system_error(network_errno, std::system_category(), "There was an IO error while attempting to wait for events on the file descriptors");
+            }
+
+            // Hold the lock while we use the watches, so they aren't changed underneath us
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            for(int i = 0; i < count; ++i) {
+                const epoll_event& event = shard.events[i];
+
+                // It's our notification handle
+                if(event.data.ptr == nullptr) {
+                    // Read our value to clear it's read status
+                    uint64_t val;
+                    if(read(shard.notify, &val, sizeof(val)) < 0 && network_errno != EAGAIN) {
+                        throw std::system_error(network_errno, std::system_category(), "There was an error reading our notification eventfd");
+                    }
+                }
+                // It's a regular handle, if the watch was removed since the event it will have no tasks
+                else {
+                    // epoll uses the same values for events as poll
+                    dispatch(shard, *static_cast<Watch*>(event.data.ptr), int(event.events));
+                }
+            }
+
+            // Now we have all of the events we can submit our batches
+            flush(shard);
+
+            // The events disabled their file descriptors, so watch them again for the reactions that aren't running
+            for(int i = 0; i < count; ++i) {
+                Watch* watch = static_cast<Watch*>(shard.events[i].data.ptr);
+                if(watch && watch->registered) {
+                    update(shard, *watch);
+                }
+            }
+
+            // None of our events can refer to removed watches anymore
+            shard.removed.clear();
+        }
+
+        void IOController::waitRing(Shard& shard) {
+
+            // Submit everything we have queued and wait for at least one completion, if some of our changes didn't fit
+            // in the queue last time we don't wait, as we need to reap to make room for them
+            shard.ring->enter(shard.deferred.empty() ? 1 : 0);
+
+            // Hold the lock while we use the watches, so they aren't changed underneath us
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            // Try the changes that didn't fit again along with the new ones
+            shard.pending.insert(shard.pending.end(), shard.deferred.begin(), shard.deferred.end());
+            shard.deferred.clear();
+
+            shard.ring->reap([this, &shard] (const io_uring_cqe& cqe) {
+
+                // The results of removing polls, their poll will complete as well
+                if(cqe.user_data == 0) {
+                    return;
+                }
+                // It's our notification handle
+                else if(cqe.user_data == uint64_t(reinterpret_cast<uintptr_t>(&shard.notify))) {
+                    uint64_t val;
+                    if(read(shard.notify, &val, sizeof(val)) < 0 && network_errno != EAGAIN) {
+                        throw std::system_error(network_errno, std::system_category(), "There was an error reading our notification eventfd");
+                    }
+                    arm(shard, nullptr);
+                }
+                // It's a regular handle
+                else {
+                    Watch& watch = *reinterpret_cast<Watch*>(uintptr_t(cqe.user_data));
+                    watch.registered = false;
+
+                    // A negative result is an error such as the poll being cancelled
+                    if(cqe.res > 0) {
+                        dispatch(shard, watch, cqe.res);
+                    }
+
+                    shard.fired.push_back(&watch);
+                }
+            });
+
+            // Now we have all of the events we can submit our batches
+            flush(shard);
+
+            // Add the polls that completed again, if they have been changed we will sort them out with the other changes
+            for(Watch* watch : shard.fired) {
+                if(!watch->queued) {
+                    if(watch->tasks.empty()) {
+                        release(shard, *watch);
+                    }
+                    // If all of its reactions are running it will be added again when one finishes
+                    else if(interest(*watch) != 0) {
+                        arm(shard, watch);
+                    }
+                }
+            }
+            shard.fired.clear();
+
+            // Apply the changes to the watches, these will be submitted with our next wait
+            for(Watch* watch : shard.pending) {
+
+                // Our eventfd's poll didn't fit last time
+                if(!watch) {
+                    arm(shard, nullptr);
+                    continue;
+                }
+
+                watch->queued = false;
+
+                if(watch->registered) {
+                    // Remove the poll if it is no longer watching for the right things, when it completes it will be
+                    // added again if it is still needed
+                    if(watch->tasks.empty() || watch->armed != interest(*watch)) {
+                        io_uring_sqe* sqe = shard.ring->next();
+                        if(!sqe) {
+                            defer(shard, watch);
+                            continue;
+                        }
+                        sqe->opcode = IORING_OP_POLL_REMOVE;
+                        sqe->fd = -1;
+                        sqe->addr = uint64_t(reinterpret_cast<uintptr_t>(watch));
+                        sqe->user_data = 0;
+                    }
+                }
+                else if(watch->tasks.empty()) {
+                    release(shard, *watch);
+                }
+                else if(interest(*watch) != 0) {
+                    arm(shard, watch);
+                }
+            }
+            shard.pending.clear();
+        }
+
+        void IOController::arm(Shard& shard, Watch* watch) {
+
+            io_uring_sqe* next = shard.ring->next();
+            if(!next) {
+                defer(shard, watch);
+                return;
+            }
+
+            io_uring_sqe& sqe = *next;
+            sqe.opcode = IORING_OP_POLL_ADD;
+
+            uint32_t mask;
+            if(watch) {
+                watch->registered = true;
+                watch->armed = interest(*watch);
+
+                sqe.fd = watch->fd;
+                sqe.user_data = uint64_t(reinterpret_cast<uintptr_t>(watch));
+                mask = watch->armed;
+            }
+            else {
+                sqe.fd = shard.notify;
+                sqe.user_data = uint64_t(reinterpret_cast<uintptr_t>(&shard.notify));
+                mask = POLLIN;
+            }
+
+            // The kernel reads the 32 bit events with their halves swapped on big endian systems
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            mask = (mask << 16) | (mask >> 16);
+#endif
+            sqe.poll32_events = mask;
+        }
+
+        void IOController::defer(Shard& shard, Watch* watch) {
+
+            // Mark the watch as queued so it isn't queued again before we get to it
+            if(watch) {
+                watch->queued = true;
+            }
+            shard.deferred.push_back(watch);
+        }
+
+        void IOController::release(Shard& shard, Watch& watch) {
+            shard.removed.erase(std::remove_if(std::begin(shard.removed), std::end(shard.removed), [&watch] (const std::unique_ptr<Watch>& w) {
+                return w.get() == &watch;
+            }), std::end(shard.removed));
+        }
+
+        uint32_t IOController::interest(const Watch& watch) {
+
+            // Errors and hangups are always reported, but we include them so a watch that only wants them is still armed
+            uint32_t out = 0;
+            for(auto& task : watch.tasks) {
+                if(!task.running) {
+                    out |= uint32_t(task.events) & (POLLIN | POLLPRI | POLLOUT | POLLERR | POLLHUP);
+                }
+            }
+            return out;
+        }
+
+        void IOController::dispatch(Shard& shard, Watch& watch, int events) {
+
+            // Loop through our tasks
+            for(auto& task : watch.tasks) {
+
+                // We should emit if the reaction is interested, and isn't still handling the last event
+                if(!task.running && (task.events & events)) {
+
+                    // Make our event to pass through
+                    IO::Event e;
+                    e.fd = watch.fd;
+                    e.events = events;
+
+                    // Batches get all their events at once when we are done
+                    if(task.batch) {
+                        auto batch = std::find_if(std::begin(shard.batches), std::end(shard.batches), [&task] (const std::pair<std::shared_ptr<threading::Reaction>, IO::Events>& b) {
+                            return b.first == task.reaction;
+                        });
+                        if(batch == std::end(shard.batches)) {
+                            shard.batches.emplace_back(task.reaction, IO::Events());
+                            batch = std::prev(std::end(shard.batches));
+                        }
+                        batch->second.push_back(e);
+                        continue;
+                    }
+
+                    // Store the event in our thread local cache, and somewhere for the get to say if it has more
+                    bool more = false;
+                    IO::ThreadEventStore::value = &e;
+                    IO::ThreadDrainStore::value = &more;
+
+                    // Submit the task (which should run the get)
+                    try {
+                        auto t = task.reaction->getTask();
+                        if(t) {
+                            // Stop watching for this reaction until its postcondition says it has finished
+                            task.running = task.oneShot;
+                            powerplant.submit(std::move(t));
+
+                            // Reactions that drain their file descriptor get a task for everything the get read
+                            while(task.drain && more && (t = task.reaction->getTask())) {
+                                powerplant.submit(std::move(t));
+                            }
+                        }
+                    }
+                    catch (...) {
+                    }
+
+                    // Reset our values
+                    IO::ThreadEventStore::value = nullptr;
+                    IO::ThreadDrainStore::value = nullptr;
+                }
+            }
+        }
+
+        void IOController::flush(Shard& shard) {
+
+            for(auto& batch : shard.batches) {
+                threading::Reaction& reaction = *batch.first;
+
+                // Store the events in our thread local cache
+                IO::ThreadEventsStore::value = &batch.second;
+
+                // Submit the task (which should run the get)
+                try {
+                    auto t = reaction.getTask();
+                    if(t) {
+                        // Stop watching for this reaction on any of its file descriptors until it has finished
+                        std::vector<fd_t> fds;
+                        {
+                            std::lock_guard<std::mutex> lock(routeMutex);
+                            auto route = routes.find(reaction.reactionId);
+                            if(route != routes.end()) {
+                                fds = route->second.fds;
+                            }
+                        }
+                        setRunning(shard, fds, reaction.reactionId, true);
+
+                        powerplant.submit(std::move(t));
+                    }
+                }
+                catch (...) {
+                }
+
+                // Reset our value
+                IO::ThreadEventsStore::value = nullptr;
+            }
+            shard.batches.clear();
+        }
+
+        void IOController::setRunning(Shard& shard, const std::vector<fd_t>& fds, uint64_t reactionId, bool running) {
+
+            for(const auto& fd : fds) {
+                auto watch = shard.watches.find(fd);
+                if(watch != shard.watches.end()) {
+                    for(auto& task : watch->second->tasks) {
+                        if(task.reaction->reactionId == reactionId && task.oneShot) {
+                            task.running = running;
+
+                            // While it is running, the next event for it will update the watch
+                            if(!running) {
+                                update(shard, *watch->second);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void IOController::finished(uint64_t reactionId) {
+
+            // Find where our reaction is watched, if it is gone it was unbound while it was running
+            Route route;
+            {
+                std::lock_guard<std::mutex> lock(routeMutex);
+                auto it = routes.find(reactionId);
+                if(it == routes.end()) {
+                    return;
+                }
+                route = it->second;
+            }
+            Shard& shard = *route.shard;
+
+            // Lock our mutex to avoid concurrent modification
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            // Start watching for its events again
+            setRunning(shard, route.fds, reactionId, false);
+        }
+
+        void IOController::update(Shard& shard, Watch& watch) {
+
+            // Only the IO thread can use the ring, so queue the watch for it and wake it up to submit the change
+            if(shard.ring) {
+                if(!watch.queued) {
+                    watch.queued = true;
+                    shard.pending.push_back(&watch);
+                    wake(shard);
+                }
+                return;
+            }
+
+            // Watches are one shot, after each event they are disabled until we modify them again
+            epoll_event event {};
+            event.events = interest(watch) | EPOLLONESHOT;
+            event.data.ptr = &watch;
+
+            // Nothing is watching anymore, it may have been closed already so we don't care if this fails
+            if(watch.tasks.empty()) {
+                epoll_ctl(shard.epoll, EPOLL_CTL_DEL, watch.fd, &event);
+                watch.registered = false;
+            }
+            // A new watch
+            else if(!watch.registered) {
+                if(epoll_ctl(shard.epoll, EPOLL_CTL_ADD, watch.fd, &event) < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "We were unable to add the file descriptor to epoll");
+                }
+                watch.registered = true;
+            }
+            // Change what we are watching for, if the fd was closed and reopened it is no longer in epoll so add it.
+            // If all of its reactions are running leave it disabled, it will be modified again when one finishes
+            else if(event.events != EPOLLONESHOT && epoll_ctl(shard.epoll, EPOLL_CTL_MOD, watch.fd, &event) < 0) {
+                if(network_errno != ENOENT || epoll_ctl(shard.epoll, EPOLL_CTL_ADD, watch.fd, &event) < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "We were unable to modify the file descriptor in epoll");
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -15,8 +15,8 @@
  * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-// Disable this file on windows
-#ifndef _WIN32
+// Disable this file on windows, and on linux where we use epoll
+#if !defined(_WIN32) && (!defined(__linux__) || defined(NUCLEAR_POLL_IO))
 
 #include "nuclear_bits/extension/IOController.hpp"
 
@@ -57,6 +57,9 @@ namespace NUClear {
                 reactions.push_back(Task {
                     config.fd,
                     static_cast<short>(config.events),
+                    config.oneShot,
+                    config.batch,
+                    config.drain,
                     config.reaction
                 });
 
@@ -77,14 +80,10 @@ namespace NUClear {
                 // Lock our mutex to avoid concurrent modification
                 std::lock_guard<std::mutex> lock(reactionMutex);
 
-                // Find our reaction
-                auto reaction = std::find_if(std::begin(reactions), std::end(reactions), [&unbind] (const Task& t) {
+                // Remove our reaction, batches have one for each of their file descriptors
+                reactions.erase(std::remove_if(std::begin(reactions), std::end(reactions), [&unbind] (const Task& t) {
                     return t.reaction->reactionId == unbind.reactionId;
-                });
-
-                if(reaction != std::end(reactions)) {
-                    reactions.erase(reaction);
-                }
+                }), std::end(reactions));
 
                 // Let the poll command know that stuff happened
                 dirty = true;
@@ -93,6 +92,11 @@ namespace NUClear {
                 }
             });
 
+            // Finished IO tasks tell us directly so they don't need a reaction of their own
+            IO::finished() = [this] (uint64_t reactionId) {
+                finished(reactionId);
+            };
+
             on<Shutdown>().then("Shutdown IO Controller", [this] {
 
                 // Set shutdown to true so it won't try to poll again
@@ -113,136 +117,218 @@ namespace NUClear {
                 // shutdown keeps us out here
                 if(!shutdown) {
 
+                    // If our list is dirty rebuild it before we poll
+                    if(dirty) {
+                        // Get the lock so we don't concurrently modify the list
+                        std::lock_guard<std::mutex> lock(reactionMutex);
 
+                        // Clear our fds to be rebuilt
+                        fds.clear();
 
+                        // Insert our notifyFd
+                        fds.push_back(pollfd { notifyRecv, POLLIN, 0 });
 
+                        for (const auto& r : reactions) {
 
-                    // TODO check for dirty here
-
-
-
+                            // Reactions that are still running are not watched until they finish
+                            if(r.running) {
+                                continue;
+                            }
 
+                            // If we are the same fd, then add our interest set
+                            if(r.fd == fds.back().fd) {
+                                fds.back().events |= r.events;
+                            }
+                            // Otherwise add a new one
+                            else {
+                                fds.push_back(pollfd { r.fd, r.events, 0 });
+                            }
+                        }
 
+                        // We just cleaned the list!
+                        dirty = false;
+                    }
 
                     // Poll our file descriptors for events
                     int result = poll(fds.data(), static_cast<nfds_t>(fds.size()), -1);
 
                     // Check if we had an error on our Poll request
                     if(result < 0) {
+                        if(network_errno == EINTR) {
+                            return;
+                        }
                         throw std::system_error(network_errno, std::system_category(), "There was an IO error while attempting to poll the file descriptors");
                     }
-                    else {
-                        for(auto& fd : fds) {
-
-                            // Something happened
-                            if(fd.revents) {
-
-                                // It's our notification handle
-                                if(fd.fd == notifyRecv) {
-                                    // Read our value to clear it's read status
-                                    char val;
-                                    if(read(fd.fd, &val, sizeof(char)) < 0) {
-                                        throw std::system_error(network_errno, std::system_category(), "There was an error reading our notification pipe?");
-                                    };
-                                }
-                                // It's a regular handle
-                                else {
-
-                                    // Find our relevant reactions
-                                    auto range = std::equal_range(std::begin(reactions)
-                                                                  , std::end(reactions)
-                                                                  , Task { fd.fd, 0, nullptr }
-                                                                  , [] (const Task& a, const Task& b) {
-                                                                      return a.fd < b.fd;
-                                                                  });
-
-
-                                    // There are no reactions for this!
-                                    if(range.first == std::end(reactions)) {
-                                        // If this happens then our list is definitely dirty...
-                                        dirty = true;
-                                    }
-                                    else {
-
 
+                    // Hold the lock while we use the reactions, so they aren't changed underneath us
+                    std::lock_guard<std::mutex> lock(reactionMutex);
 
+                    // The events we find for each batch reaction
+                    std::vector<std::pair<std::shared_ptr<threading::Reaction>, IO::Events>> batches;
 
-                                        // TODO we also want to swap this element to the back of the list and remove it
-                                        // so that it does not fire again
+                    for(size_t i = 0; i < fds.size();) {
+                        pollfd& fd = fds[i];
 
+                        // Nothing happened
+                        if(!fd.revents) {
+                            ++i;
+                            continue;
+                        }
 
+                        // It's our notification handle
+                        if(fd.fd == notifyRecv) {
+                            // Read our value to clear it's read status
+                            char val;
+                            if(read(fd.fd, &val, sizeof(char)) < 0) {
+                                throw std::system_error(network_errno, std::system_category(), "There was an error reading our notification pipe?");
+                            };
+                        }
+                        // It's a regular handle
+                        else {
+
+                            // Find our relevant reactions
+                            auto range = std::equal_range(std::begin(reactions)
+                                                          , std::end(reactions)
+                                                          , Task { fd.fd, 0, false, false, false, nullptr }
+                                                          , [] (const Task& a, const Task& b) {
+                                                              return a.fd < b.fd;
+                                                          });
+
+                            // What we are still waiting for once the tasks we submit are running
+                            short remaining = 0;
+
+                            // Loop through our values
+                            for(auto it = range.first; it != range.second; ++it) {
+
+                                // We should emit if the reaction is interested, and isn't still handling the last event
+                                if(!it->running && (it->events & fd.revents)) {
+
+                                    // Make our event to pass through
+                                    IO::Event e;
+                                    e.fd = fd.fd;
+
+                                    // Evaluate and store our set in thread store
+                                    e.events = fd.revents;
+
+                                    // Batches get all their events at once when we are done
+                                    if(it->batch) {
+                                        auto batch = std::find_if(std::begin(batches), std::end(batches), [it] (const std::pair<std::shared_ptr<threading::Reaction>, IO::Events>& b) {
+                                            return b.first == it->reaction;
+                                        });
+                                        if(batch == std::end(batches)) {
+                                            batches.emplace_back(it->reaction, IO::Events());
+                                            batch = std::prev(std::end(batches));
+                                        }
+                                        batch->second.push_back(e);
+                                        remaining |= it->events;
+                                        continue;
+                                    }
 
+                                    // Store the event in our thread local cache, and somewhere for the get to say if it has more
+                                    bool more = false;
+                                    IO::ThreadEventStore::value = &e;
+                                    IO::ThreadDrainStore::value = &more;
+
+                                    // Submit the task (which should run the get)
+                                    try {
+                                        auto task = it->reaction->getTask();
+                                        if(task) {
+                                            // Stop watching for this reaction until its postcondition says it has finished
+                                            it->running = it->oneShot;
+                                            powerplant.submit(std::move(task));
+
+                                            // Reactions that drain their file descriptor get a task for everything the get read
+                                            while(it->drain && more && (task = it->reaction->getTask())) {
+                                                powerplant.submit(std::move(task));
+                                            }
+                                        }
+                                    }
+                                    catch (...) {
+                                    }
 
-                                        // Loop through our values
-                                        for(auto it = range.first; it != range.second; ++it) {
+                                    // Reset our values
+                                    IO::ThreadEventStore::value = nullptr;
+                                    IO::ThreadDrainStore::value = nullptr;
+                                }
 
-                                            // We should emit if the reaction is interested
-                                            if (it->events & fd.revents) {
+                                if(!it->running) {
+                                    remaining |= it->events;
+                                }
+                            }
 
-                                                // Make our event to pass through
-                                                IO::Event e;
-                                                e.fd = fd.fd;
+                            // If nothing is waiting for this fd anymore swap it to the back of the list and remove it
+                            // so that it does not fire again, the element swapped in still needs to be looked at
+                            if(remaining == 0) {
+                                std::swap(fd, fds.back());
+                                fds.pop_back();
+                                continue;
+                            }
 
-                                                // Evaluate and store our set in thread store
-                                                e.events = fd.revents;
+                            fd.events = remaining;
+                        }
 
-                                                // Store the event in our thread local cache
-                                                IO::ThreadEventStore::value = &e;
+                        // Reset our events
+                        fd.revents = 0;
+                        ++i;
+                    }
 
-                                                // Submit the task (which should run the get)
-                                                try {
-                                                    auto task = it->reaction->getTask();
-                                                    if(task) {
-                                                        powerplant.submit(std::move(task));
-                                                    }
-                                                }
-                                                catch (...) {
-                                                }
+                    for(auto& batch : batches) {
 
-                                                // Reset our value
-                                                IO::ThreadEventStore::value = nullptr;
+                        // Store the events in our thread local cache
+                        IO::ThreadEventsStore::value = &batch.second;
 
-                                                // TODO If we had a close, or error stop listening?
-                                            }
-                                        }
-                                    }
+                        // Submit the task (which should run the get)
+                        try {
+                            auto task = batch.first->getTask();
+                            if(task) {
+                                // Stop watching for this reaction on any of its file descriptors until it has finished
+                                if(setRunning(batch.first->reactionId, true)) {
+                                    dirty = true;
                                 }
-
-                                // Reset our events
-                                fd.revents = 0;
+                                powerplant.submit(std::move(task));
                             }
                         }
+                        catch (...) {
+                        }
 
-                        // If our list is dirty
-                        if(dirty) {
-                            // Get the lock so we don't concurrently modify the list
-                            std::lock_guard<std::mutex> lock(reactionMutex);
+                        // Reset our value
+                        IO::ThreadEventsStore::value = nullptr;
+                    }
+                }
+            });
 
-                            // Clear our fds to be rebuilt
-                            fds.clear();
+        }
 
-                            // Insert our notifyFd
-                            fds.push_back(pollfd { notifyRecv, POLLIN, 0 });
+        IOController::~IOController() {
+            IO::finished() = nullptr;
+        }
 
-                            for (const auto& r : reactions) {
+        void IOController::finished(uint64_t reactionId) {
 
-                                // If we are the same fd, then add our interest set
-                                if(r.fd == fds.back().fd) {
-                                    fds.back().events |= r.events;
-                                }
-                                // Otherwise add a new one
-                                else {
-                                    fds.push_back(pollfd { r.fd, r.events, 0 });
-                                }
-                            }
+            // Lock our mutex to avoid concurrent modification
+            std::lock_guard<std::mutex> lock(reactionMutex);
 
-                            // We just cleaned the list!
-                            dirty = false;
-                        }
-                    }
+            // Start watching for its events again, if it is gone it was unbound while it was running
+            if(setRunning(reactionId, false)) {
+
+                // Let the poll command know that stuff happened
+                dirty = true;
+                if(write(notifySend, &dirty, 1) < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "There was an error while writing to the notification pipe");
                 }
-            });
+            }
+        }
 
+        bool IOController::setRunning(uint64_t reactionId, bool running) {
+
+            bool found = false;
+            for(auto& r : reactions) {
+                if(r.reaction->reactionId == reactionId && r.oneShot) {
+                    r.running = running;
+                    found = true;
+                }
+            }
+            return found;
         }
     }
 }
@@ -54,7 +54,7 @@ namespace NUClear {
                 WSAEventSelect(config.fd, event, config.events);
 
                 // Add all the information to the list
-                reactions.insert(std::make_pair(event, Event{config.fd, config.reaction, config.events}));
+                reactions.insert(std::make_pair(event, Event{config.fd, config.reaction, config.events, config.drain}));
 
                 // Also add it to the end of our watching list
                 fds.push_back(event);
@@ -119,21 +119,29 @@ namespace NUClear {
                                 // Our events are what we got from the enum events call
                                 e.events = wsae.lNetworkEvents;
 
-                                // Store the event in our thread local cache
+                                // Store the event in our thread local cache, and somewhere for the get to say if it has more
+                                bool more = false;
                                 IO::ThreadEventStore::value = &e;
+                                IO::ThreadDrainStore::value = &more;
 
                                 // Submit the task (which should run the get)
                                 try {
                                     auto task = r->second.reaction->getTask();
                                     if(task) {
                                         powerplant.submit(std::move(task));
+
+                                        // Reactions that drain their socket get a task for everything the get read
+                                        while(r->second.drain && more && (task = r->second.reaction->getTask())) {
+                                            powerplant.submit(std::move(task));
+                                        }
                                     }
                                 }
                                 catch (...) {
                                 }
 
-                                // Reset our value
+                                // Reset our values
                                 IO::ThreadEventStore::value = nullptr;
+                                IO::ThreadDrainStore::value = nullptr;
 
                             }
                         }
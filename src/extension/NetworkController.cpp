@@ -45,6 +45,7 @@ namespace NUClear {
         , tcpPort(0)
         , udpServerFD(0)
         , tcpServerFD(0)
+        , udpGSO(false)
         , packetIDSource(1)
         , reactionMutex()
         , reactions()
@@ -140,10 +141,23 @@ namespace NUClear {
                     tcpConnection(connection);
                 });
 
-                std::tie(multicastHandle, std::ignore, std::ignore) = on<UDP::Multicast, Sync<NetworkController>>(multicastGroup, multicastPort).then([this] (const UDP::Packet& packet) {
+                fd_t multicastFD;
+                std::tie(multicastHandle, std::ignore, multicastFD) = on<UDP::Multicast, Sync<NetworkController>>(multicastGroup, multicastPort).then([this] (const UDP::Packet& packet) {
                     udpHandler(packet);
                 });
 
+                // Have the kernel join the packets of large messages together so we can read them all at once
+                UDP::enableGRO(udpServerFD);
+                UDP::enableGRO(multicastFD);
+
+                // See if the kernel can split our large messages into packets for us
+                udpGSO = false;
+                #ifdef __linux__
+                    int segment;
+                    socklen_t len = sizeof(segment);
+                    udpGSO = ::getsockopt(udpServerFD, SOL_UDP, UDP_SEGMENT, &segment, &len) == 0;
+                #endif
+
                 multicastEmitHandle = on<Every<1, std::chrono::seconds>, Single, Sync<NetworkController>>().then([this] {
                     announce();
                 });
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nuclear_bits/extension/ReactionHistogramController.hpp"
+
+#include "nuclear_bits/dsl/store/TypeCallbackStore.hpp"
+#include "nuclear_bits/message/ReactionHistogramSnapshot.hpp"
+
+namespace NUClear {
+    namespace extension {
+
+        ReactionHistogramController::ReactionHistogramController(std::unique_ptr<NUClear::Environment> environment)
+        : Reactor(std::move(environment))
+        , start(clock::now()) {
+
+            const clock::duration& period = powerplant.configuration.histogramPeriod;
+
+            if (period > clock::duration(0)) {
+                on<dsl::word::Every<>>(period).then("Reaction Histogram Snapshot", [this] {
+
+                    // If nobody is listening leave the histograms to keep accumulating until someone is
+                    if (dsl::store::TypeCallbackStore<message::ReactionHistogramSnapshot>::get().empty()) {
+                        return;
+                    }
+
+                    auto snapshot = std::make_unique<message::ReactionHistogramSnapshot>();
+
+                    // This snapshot covers everything since our last one
+                    snapshot->start = start;
+                    snapshot->end = clock::now();
+                    start = snapshot->end;
+
+                    // Collect and reset the histograms of every reaction
+                    threading::Reaction::snapshotHistograms(*snapshot);
+
+                    emit(snapshot);
+                });
+            }
+        }
+
+    }  // namespace extension
+}  // namespace NUClear
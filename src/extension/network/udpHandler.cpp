@@ -190,7 +190,7 @@ namespace NUClear {
                             std::vector<char> payload;
 
                             // Sort the list
-                            std::sort(set.second.begin(), set.second.end(), [] (const std::vector<char>& a, const std::vector<char>& b) {
+                            std::sort(set.second.begin(), set.second.end(), [] (const util::BufferPool::Buffer& a, const util::BufferPool::Buffer& b) {
                                 const network::DataPacket& pA = *reinterpret_cast<const network::DataPacket*>(a.data());
                                 const network::DataPacket& pB = *reinterpret_cast<const network::DataPacket*>(b.data());
                                 return pA.packetNo < pB.packetNo;
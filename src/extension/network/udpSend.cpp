@@ -29,25 +29,40 @@ namespace NUClear {
 
         void NetworkController::udpSend(const NetworkEmit& emit) {
 
-            // Make our message struct
-            msghdr message;
-            std::memset(&message, 0, sizeof(msghdr));
+            // Work out who we are sending to
+            std::vector<sockaddr_in> destinations;
 
-            // Create our iovec
-            iovec data[2];
-            message.msg_iov    = data;
-            message.msg_iovlen = 2;
+            // Send multicast
+            if (emit.target.empty()) {
 
-            // The first element in our iovec is the header
-            network::DataPacket header;
-            data[0].iov_base = reinterpret_cast<char*>(&header);
-            data[0].iov_len = sizeof(network::DataPacket) - 1;
+                // Multicast address
+                sockaddr_in target;
+                std::memset(&target, 0, sizeof(sockaddr_in));
+                target.sin_family = AF_INET;
+                inet_pton(AF_INET, multicastGroup.c_str(), &target.sin_addr);
+                target.sin_port = htons(multicastPort);
+
+                destinations.push_back(target);
+            }
+            // Send unicast
+            else {
+                auto sendTo = nameTarget.equal_range(emit.target);
+
+                for(auto it = sendTo.first; it != sendTo.second; ++it) {
 
-            // Some references for easy access to our data memory
-            auto& base = data[1].iov_base;
-            auto& len  = data[1].iov_len;
+                    // Unicast address
+                    sockaddr_in target;
+                    std::memset(&target, 0, sizeof(sockaddr_in));
+                    target.sin_family = AF_INET;
+                    target.sin_addr.s_addr = htonl(it->second->address);
+                    target.sin_port = htons(it->second->udpPort);
+
+                    destinations.push_back(target);
+                }
+            }
 
             // Set some common information for the header
+            network::DataPacket header;
             header.type = network::DATA;
             header.packetId = ++packetIDSource;
             header.packetNo = 0;
@@ -55,55 +70,84 @@ namespace NUClear {
             header.multicast = emit.target.empty();
             header.hash = emit.hash;
 
+            // Each packet is its header followed by its chunk of the payload, so we make them all up front
+            size_t packets = (emit.data.size() + MAX_UDP_PAYLOAD_LENGTH - 1) / MAX_UDP_PAYLOAD_LENGTH;
+            std::vector<network::DataPacket> headers;
+            std::vector<iovec> data(packets * 2);
+            headers.reserve(packets);
+
             // Loop through our chunks
-            for (size_t i = 0; i < emit.data.size(); i += MAX_UDP_PAYLOAD_LENGTH) {
+            for (size_t i = 0, p = 0; i < emit.data.size(); i += MAX_UDP_PAYLOAD_LENGTH, ++p) {
 
                 // Store our payload information for this chunk
+                auto& base = data[p * 2 + 1].iov_base;
+                auto& len  = data[p * 2 + 1].iov_len;
                 base = const_cast<char*>(emit.data.data() + i);
                 len = (i + MAX_UDP_PAYLOAD_LENGTH) < emit.data.size() ? MAX_UDP_PAYLOAD_LENGTH : emit.data.size() % MAX_UDP_PAYLOAD_LENGTH;
 
                 // Work out our header length
                 header.length = uint32_t(len + sizeof(network::DataPacket) - sizeof(network::PacketHeader) - 1);
 
-                // Send multicast
-                if (emit.target.empty()) {
-
-                    // Multicast address
-                    sockaddr_in target;
-                    std::memset(&target, 0, sizeof(sockaddr_in));
-                    target.sin_family = AF_INET;
-                    inet_pton(AF_INET, multicastGroup.c_str(), &target.sin_addr);
-                    target.sin_port = htons(multicastPort);
+                // The first element in our iovec is the header
+                headers.push_back(header);
+                data[p * 2].iov_base = reinterpret_cast<char*>(&headers.back());
+                data[p * 2].iov_len = sizeof(network::DataPacket) - 1;
 
-                    message.msg_name = reinterpret_cast<sockaddr*>(&target);
-                    message.msg_namelen = sizeof(sockaddr_in);
+                // Increment to send the next packet
+                ++header.packetNo;
+            }
 
-                    // Send the packet
-                    sendmsg(udpServerFD, &message, 0);
+            for (auto& target : destinations) {
+
+                // Make our message struct
+                msghdr message;
+                std::memset(&message, 0, sizeof(msghdr));
+                message.msg_name = reinterpret_cast<sockaddr*>(&target);
+                message.msg_namelen = sizeof(sockaddr_in);
+
+                size_t sent = 0;
+
+                #ifdef __linux__
+                // Let the kernel split our packets apart (GSO), only the last packet can be short so it ends a send
+                while (udpGSO && packets - sent > 1) {
+                    size_t count = std::min(packets - sent, size_t(MAX_UDP_SEGMENTS));
+
+                    // Tell the kernel how big each packet is
+                    char cmbuff[CMSG_SPACE(sizeof(uint16_t))] = { 0 };
+                    message.msg_control = cmbuff;
+                    message.msg_controllen = sizeof(cmbuff);
+                    cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+                    cmsg->cmsg_level = SOL_UDP;
+                    cmsg->cmsg_type = UDP_SEGMENT;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                    uint16_t segment = uint16_t(UDP_SEGMENT_LENGTH);
+                    std::memcpy(CMSG_DATA(cmsg), &segment, sizeof(uint16_t));
+
+                    message.msg_iov    = &data[sent * 2];
+                    message.msg_iovlen = count * 2;
+
+                    if (sendmsg(udpServerFD, &message, 0) < 0) {
+                        // The kernel or the network device can't do it after all (or the MTU is too small for our
+                        // packets to go unfragmented), so we send the packets ourselves
+                        if (errno == EIO || errno == EINVAL || errno == EMSGSIZE || errno == ENOPROTOOPT || errno == EOPNOTSUPP) {
+                            udpGSO = false;
+                        }
+                        break;
+                    }
+                    sent += count;
                 }
-                // Send unicast
-                else {
-                    auto sendTo = nameTarget.equal_range(emit.target);
-
-                    for(auto it = sendTo.first; it != sendTo.second; ++it) {
+                message.msg_control = nullptr;
+                message.msg_controllen = 0;
+                #endif
 
-                        // Unicast address
-                        sockaddr_in target;
-                        std::memset(&target, 0, sizeof(sockaddr_in));
-                        target.sin_family = AF_INET;
-                        target.sin_addr.s_addr = htonl(it->second->address);
-                        target.sin_port = htons(it->second->udpPort);
+                // Send the rest of the packets one at a time
+                for (; sent < packets; ++sent) {
+                    message.msg_iov    = &data[sent * 2];
+                    message.msg_iovlen = 2;
 
-                        message.msg_name = reinterpret_cast<sockaddr*>(&target);
-                        message.msg_namelen = sizeof(sockaddr_in);
-
-                        // Send the packet
-                        sendmsg(udpServerFD, &message, 0);
-                    }
+                    // Send the packet
+                    sendmsg(udpServerFD, &message, 0);
                 }
-
-                // Increment to send the next packet
-                ++header.packetNo;
             }
         }
     }
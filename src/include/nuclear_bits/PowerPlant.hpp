@@ -64,16 +64,44 @@ namespace NUClear {
          * @brief This class holds the configuration for a PowerPlant.
          *
          * @details
-         *  It configures the number of threads that will be in the PowerPlants thread pool
+         *  It configures the number of threads that will be in the PowerPlants thread pool, how often reaction
+         *  statistics are collected, how often reaction latency histograms are emitted and how NUClear::clock runs.
          *
          * @author Trent Houliston
          */
         struct Configuration {
             /// @brief default to the amount of hardware concurrency (or 2) threads
-            Configuration() : threadCount(std::thread::hardware_concurrency() == 0 ? 2 : std::thread::hardware_concurrency()) {}
+            Configuration() : threadCount(std::thread::hardware_concurrency() == 0 ? 2 : std::thread::hardware_concurrency())
+                            , statisticsSampleRate(1)
+                            , histogramPeriod(std::chrono::seconds(1))
+                            , multiplexTimers(false)
+                            , clockRate(1.0)
+                            , fastForward(false)
+                            , ioUring(false)
+                            , ioThreads(1) {}
 
             /// @brief The number of threads the system will use
             size_t threadCount;
+            /// @brief Reaction statistics are collected for one in every this many tasks of each reaction
+            size_t statisticsSampleRate;
+            /// @brief How often a ReactionHistogramSnapshot is emitted, zero to never emit them
+            clock::duration histogramPeriod;
+            /// @brief On Linux, run Every reactions from a timerfd in the IO controller rather than a dedicated thread.
+            ///        This frees a thread and doesn't busy wait, but the reactions won't start as accurately
+            bool multiplexTimers;
+            /// @brief How fast NUClear::clock runs compared to real time while this PowerPlant exists, for example 10
+            ///        runs a scenario ten times faster. Zero stops the clock so that it only moves by fast forwarding
+            double clockRate;
+            /// @brief When there are no tasks queued or running, jump NUClear::clock forward to the next Every reaction
+            ///        rather than waiting for it. Reactions that wait on anything other than the clock (such as IO or
+            ///        their own threads) will see time move quickly while they wait
+            bool fastForward;
+            /// @brief On Linux, wait for IO with io_uring rather than epoll. If the kernel doesn't support io_uring or
+            ///        won't let us use it, epoll is used anyway
+            bool ioUring;
+            /// @brief On Linux, the number of threads that wait for IO. Each watches its own share of the file
+            ///        descriptors, which are divided between them by their number
+            size_t ioThreads;
         };
 
         /// @brief Holds the configuration information for this PowerPlant (such as number of pool threads)
@@ -128,6 +156,26 @@ namespace NUClear {
          */
         void addThreadTask(std::function<void ()>&& task);
 
+        /**
+         * @brief Checks if there are no tasks queued or running on the pool or main thread.
+         *
+         * @details
+         *  Threads added with addThreadTask (such as those used by Always) are not counted.
+         */
+        bool idle();
+
+        /**
+         * @brief Sets a function that is called when the pool and main thread run out of tasks.
+         *
+         * @details
+         *  There is only one of these, it is used by the ChronoController to fast forward the clock. The function may
+         *  be called while a thread is holding no locks, but it may also find that new tasks have been submitted by
+         *  the time it runs, so check idle again if it matters.
+         *
+         * @param func the function to call
+         */
+        void onIdle(std::function<void ()>&& func);
+
         /**
          * @brief Installs a reactor of a particular type to the system.
          *
@@ -149,6 +197,13 @@ namespace NUClear {
          */
         void submit(std::unique_ptr<threading::ReactionTask>&& task);
 
+        /**
+         * @brief Submits a group of new tasks to the ThreadPool to be queued and then executed.
+         *
+         * @param tasks The Reaction tasks to be executed in the thread pool
+         */
+        void submit(std::vector<std::unique_ptr<threading::ReactionTask>>&& tasks);
+
         /**
          * @brief Submits a new task to the main threads thread pool to be queued and then executed.
          *
@@ -204,6 +259,26 @@ namespace NUClear {
         template <template <typename> class TFirstHandler, template <typename> class... THandlers, typename TData, typename... TArgs>
         void emit(std::unique_ptr<TData>& data, TArgs&&... args);
 
+        /**
+         * @brief Emits a batch of data of a single type to the system.
+         *
+         * @details
+         *  Each element of the batch is routed as though it was emitted individually, however the handlers are able to
+         *  do the work for all of the elements in a single pass. Handlers must provide an emit function that accepts a
+         *  vector of data to be used for a batch emit.
+         *
+         * @tparam TFirstHandler    the first handler to use for this emit
+         * @tparam THandlers        the remaining handlers to use for this emit
+         * @tparam TData            the type of the data that we are emitting
+         * @tparam TArgs            the additional arguments that will be provided to the handlers
+         *
+         * @param data The batch of data we are emitting, this must be moved in as its elements are taken from it
+         */
+        template <typename TData>
+        void emit(std::vector<std::unique_ptr<TData>>&& data);
+        template <template <typename> class TFirstHandler, template <typename> class... THandlers, typename TData, typename... TArgs>
+        void emit(std::vector<std::unique_ptr<TData>>&& data, TArgs&&... args);
+
     private:
         /// @brief A list of tasks that must be run when the powerplant starts up
         std::vector<std::function<void ()>> tasks;
@@ -238,9 +313,13 @@ namespace NUClear {
 #include "nuclear_bits/dsl/word/emit/Initialize.hpp"
 
 // Built in smart types
+#include "nuclear_bits/message/ChronoConfiguration.hpp"
 #include "nuclear_bits/message/CommandLineArguments.hpp"
+#include "nuclear_bits/message/EveryJitterSnapshot.hpp"
+#include "nuclear_bits/message/FileWritten.hpp"
 #include "nuclear_bits/message/NetworkConfiguration.hpp"
 #include "nuclear_bits/message/NetworkEvent.hpp"
+#include "nuclear_bits/message/ReactionHistogramSnapshot.hpp"
 
 // Header which stops reaction statisitcs messages from triggering themselves
 #include "nuclear_bits/dsl/operation/ReactionStatisticsDeloop.hpp"
@@ -84,6 +84,38 @@ namespace NUClear {
         FusionFunction::call(*this, ptr, std::forward<TArgs>(args)...);
     }
 
+    // Default batch emit with no types
+    template <typename TData>
+    void PowerPlant::emit(std::vector<std::unique_ptr<TData>>&& data) {
+
+        emit<dsl::word::emit::Local>(std::move(data));
+    }
+
+    // Global batch emit handlers
+    template <template <typename> class TFirstHandler, template <typename> class... THandlers, typename TData,  typename... TArgs>
+    void PowerPlant::emit(std::vector<std::unique_ptr<TData>>&& data, TArgs&&... args) {
+
+        // Release all of our data from their pointers and wrap them in shared_ptrs
+        std::vector<std::shared_ptr<TData>> batch;
+        batch.reserve(data.size());
+        for(auto& d : data) {
+            batch.push_back(std::shared_ptr<TData>(std::move(d)));
+        }
+        data.clear();
+
+        using Functions = std::tuple<TFirstHandler<TData>, THandlers<TData>...>;
+        using Arguments = decltype(std::forward_as_tuple(*this, batch, std::forward<TArgs>(args)...));
+        using CallerArgs = std::tuple<>;
+        using FusionFunction = util::FunctionFusion<Functions, Arguments, EmitCaller, CallerArgs, 2>;
+
+        // Provide a check to make sure they are passing us the right stuff
+        static_assert(FusionFunction::value,
+                      "There was an error with the arguments for the batch emit function, Check that your scope supports batch emits and your arguments match what you are trying to do.");
+
+        // Fuse our emit handlers and call the fused function
+        FusionFunction::call(*this, batch, std::forward<TArgs>(args)...);
+    }
+
     // Anonymous metafunction that concatenates everything into a single string
     namespace {
         template <typename TFirst>
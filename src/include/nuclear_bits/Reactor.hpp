@@ -72,6 +72,12 @@ namespace NUClear {
             template <typename...>
             struct With;
 
+            template <typename>
+            struct Batch;
+
+            template <typename, typename>
+            struct WithNearest;
+
             struct Startup;
 
             struct Shutdown;
@@ -87,9 +93,14 @@ namespace NUClear {
             template <int>
             struct Buffer;
 
+            template <int, typename>
+            struct Throttle;
+
             template <typename>
             struct Sync;
 
+            struct FileRead;
+
             namespace emit {
                 template <typename TData>
                 struct Local;
@@ -101,6 +112,8 @@ namespace NUClear {
                 struct Network;
                 template <typename TData>
                 struct UDP;
+                template <typename TData>
+                struct File;
             }
         }
     }
@@ -176,10 +189,21 @@ namespace NUClear {
         /// @copydoc dsl::word::TCP
         using TCP = dsl::word::TCP;
 
+        /// @copydoc dsl::word::FileRead
+        using FileRead = dsl::word::FileRead;
+
         /// @copydoc dsl::word::With
         template <typename... TWiths>
         using With = dsl::word::With<TWiths...>;
 
+        /// @copydoc dsl::word::WithNearest
+        template <typename TData, typename TReference = void>
+        using WithNearest = dsl::word::WithNearest<TData, TReference>;
+
+        /// @copydoc dsl::word::Batch
+        template <typename TData>
+        using Batch = dsl::word::Batch<TData>;
+
         /// @copydoc dsl::word::Optional
         template <typename... TDSL>
         using Optional = dsl::word::Optional<TDSL...>;
@@ -223,6 +247,10 @@ namespace NUClear {
         template <int N>
         using Buffer = dsl::word::Buffer<N>;
 
+        /// @copydoc dsl::word::Throttle
+        template <int N, class period = std::chrono::seconds>
+        using Throttle = dsl::word::Throttle<N, period>;
+
         struct Scope {
             /// @copydoc dsl::word::emit::Local
             template <typename TData>
@@ -243,6 +271,10 @@ namespace NUClear {
             /// @copydoc dsl::word::emit::Network
             template <typename TData>
             using UDP = dsl::word::emit::UDP<TData>;
+
+            /// @copydoc dsl::word::emit::File
+            template <typename TData>
+            using FILE = dsl::word::emit::File<TData>;
         };
 
         /// @brief This provides functions to modify how an on statement runs after it has been created
@@ -350,6 +382,24 @@ namespace NUClear {
             powerplant.emit<THandlers...>(std::forward<std::unique_ptr<TData>>(data), std::forward<TArgs>(args)...);
         }
 
+        /**
+         * @brief Emits a batch of data of a single type into the system so that other reactors can use it.
+         *
+         * @details
+         *  Each element triggers reactions as if it was emitted individually, and the last element becomes the new
+         *  data used when a with is used. Reactions that trigger on Batch<TData> will receive all of the elements
+         *  in a single task.
+         *
+         * @tparam THandlers    The handlers for this emit (e.g. LOCAL)
+         * @tparam TData        The type of the data we are emitting
+         *
+         * @param data The batch of data to emit, this must be moved in as its elements are taken from it
+         */
+        template <template <typename> class... THandlers, typename TData, typename... TArgs>
+        void emit(std::vector<std::unique_ptr<TData>>&& data, TArgs&&... args) {
+            powerplant.emit<THandlers...>(std::move(data), std::forward<TArgs>(args)...);
+        }
+
         /**
          * @brief Log a message through NUClear's system.
          *
@@ -379,9 +429,12 @@ namespace NUClear {
 #include "nuclear_bits/dsl/word/IO.hpp"
 #include "nuclear_bits/dsl/word/UDP.hpp"
 #include "nuclear_bits/dsl/word/TCP.hpp"
+#include "nuclear_bits/dsl/word/FileRead.hpp"
 #include "nuclear_bits/dsl/word/Trigger.hpp"
 #include "nuclear_bits/dsl/word/Priority.hpp"
 #include "nuclear_bits/dsl/word/With.hpp"
+#include "nuclear_bits/dsl/word/WithNearest.hpp"
+#include "nuclear_bits/dsl/word/Batch.hpp"
 #include "nuclear_bits/dsl/word/Startup.hpp"
 #include "nuclear_bits/dsl/word/Network.hpp"
 #include "nuclear_bits/dsl/word/Shutdown.hpp"
@@ -391,11 +444,13 @@ namespace NUClear {
 #include "nuclear_bits/dsl/word/Every.hpp"
 #include "nuclear_bits/dsl/word/Single.hpp"
 #include "nuclear_bits/dsl/word/Buffer.hpp"
+#include "nuclear_bits/dsl/word/Throttle.hpp"
 #include "nuclear_bits/dsl/word/Sync.hpp"
 #include "nuclear_bits/dsl/word/emit/Local.hpp"
 #include "nuclear_bits/dsl/word/emit/Initialize.hpp"
 #include "nuclear_bits/dsl/word/emit/Direct.hpp"
 #include "nuclear_bits/dsl/word/emit/Network.hpp"
 #include "nuclear_bits/dsl/word/emit/UDP.hpp"
+#include "nuclear_bits/dsl/word/emit/File.hpp"
 
 #endif  // NUCLEAR_REACTOR_HPP
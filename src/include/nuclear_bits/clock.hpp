@@ -21,8 +21,82 @@
 
 namespace NUClear {
 
-    /// @brief The clock that is used throughout the entire nuclear system
-    using clock = std::chrono::high_resolution_clock;
+    /**
+     * @brief The clock that is used throughout the entire nuclear system.
+     *
+     * @details
+     *  By default this reads the system's high resolution clock. It can instead be made to run from a chosen start
+     *  time at a multiple of real time, and be jumped forward, so that replays and tests of long running scenarios
+     *  don't have to run in wall clock time. Its time points are the same type as the high resolution clock's, so
+     *  existing timestamps can be compared with it.
+     *
+     * @attention
+     *  Because the time points are the base clock's type, passing one to wait_until or sleep_until waits for that time
+     *  on the base clock rather than on this clock. Convert it with base() first when the clock may be virtual.
+     */
+    struct clock {
+        /// @brief The real clock that this clock runs from
+        using base_clock = std::chrono::high_resolution_clock;
+
+        using rep        = base_clock::rep;
+        using period     = base_clock::period;
+        using duration   = base_clock::duration;
+        using time_point = base_clock::time_point;
+
+        /// @brief A virtual clock can be jumped forward so it is never steady
+        static constexpr bool is_steady = false;
+
+        /**
+         * @brief Gets the current time.
+         *
+         * @details
+         *  When the clock is real this is just a read of the base clock.
+         */
+        static time_point now();
+
+        /**
+         * @brief Makes the clock virtual, reading start now and then running at rate times real time.
+         *
+         * @param start the time the clock should read now
+         * @param rate  how fast the clock runs compared to real time, zero for a clock that only moves when advanced
+         */
+        static void set(const time_point& start, double rate);
+
+        /**
+         * @brief Goes back to reading the base clock directly.
+         */
+        static void reset();
+
+        /**
+         * @brief Jumps a virtual clock forward by the given amount, this has no effect on a real clock.
+         *
+         * @param amount how far to move the clock forward
+         */
+        static void advance(const duration& amount);
+
+        /**
+         * @brief Gets how fast the clock runs compared to real time.
+         */
+        static double rate();
+
+        /**
+         * @brief Gets how much real time it will take for the clock to move by the given amount.
+         *
+         * @return the real time needed, or duration::max() if the clock only moves when advanced
+         */
+        static duration real(const duration& amount);
+
+        /**
+         * @brief Gets the time on the base clock at which this clock will read the given time.
+         *
+         * @details
+         *  Use this to wait for a time on this clock with functions that wait on the base clock, such as wait_until.
+         *  The result only holds until the clock is next set or advanced.
+         *
+         * @return the base clock time, or time_point::max() if the clock only moves when advanced
+         */
+        static time_point base(const time_point& time);
+    };
 
 }  // namespace NUClear
 
@@ -18,8 +18,12 @@
 #ifndef NUCLEAR_DSL_OPERATION_CACHEGET_HPP
 #define NUCLEAR_DSL_OPERATION_CACHEGET_HPP
 
+#include <memory>
+#include <utility>
+
 #include "nuclear_bits/util/MetaProgramming.hpp"
 #include "nuclear_bits/dsl/store/DataStore.hpp"
+#include "nuclear_bits/dsl/store/ThreadStore.hpp"
 
 namespace NUClear {
     namespace dsl {
@@ -28,9 +32,48 @@ namespace NUClear {
             template <typename TType>
             struct CacheGet {
 
+            private:
+                /**
+                 * @brief Gets the data from the DataStore using a per thread cache.
+                 *
+                 * @details
+                 *  Each thread keeps its own reference to the data and only loads it from the store again once the
+                 *  store's version has changed. That reference lives in a control block owned by this thread, and the
+                 *  pointers we hand out alias it, so a cache hit only touches this thread's reference count rather than
+                 *  the count that every thread reading this type shares.
+                 *
+                 * @attention
+                 *  Each thread holds the last value it read of every type it reads through this cache. A value that has
+                 *  since been replaced in the store stays alive until that thread reads the same type again (or exits),
+                 *  so with large messages each pool thread may keep one stale copy of them alive.
+                 *
+                 * @return the latest data from the DataStore
+                 */
+                static inline std::shared_ptr<TType> cached() {
+
+                    static thread_local std::pair<uint64_t, std::shared_ptr<std::shared_ptr<TType>>> cache(0, nullptr);
+
+                    uint64_t version = store::DataStore<TType>::version();
+                    if(cache.first != version) {
+                        std::shared_ptr<TType> latest = store::DataStore<TType>::get();
+                        cache.second = latest ? std::make_shared<std::shared_ptr<TType>>(std::move(latest)) : nullptr;
+                        cache.first = version;
+                    }
+
+                    return cache.second ? std::shared_ptr<TType>(cache.second, cache.second->get()) : nullptr;
+                }
+
+            public:
                 template <typename DSL, typename T = TType>
                 static inline std::shared_ptr<const T> get(threading::Reaction&) {
-                    return store::DataStore<TType>::get();
+
+                    // If we are in the middle of a batch emit, use the element that is being dispatched
+                    if(store::ThreadStore<std::shared_ptr<TType>>::value) {
+                        return *store::ThreadStore<std::shared_ptr<TType>>::value;
+                    }
+                    else {
+                        return cached();
+                    }
                 }
             };
 
@@ -0,0 +1,384 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_STORE_TIMESTORE_HPP
+#define NUCLEAR_DSL_STORE_TIMESTORE_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "nuclear_bits/clock.hpp"
+#include "nuclear_bits/dsl/trait/timestamp.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace store {
+
+            /**
+             * @brief The number of messages of a type that are kept to search through.
+             *
+             * @details
+             *  This is the capacity given in the type's timestamp trait, or 256 if the trait doesn't give one.
+             */
+            template <typename TData, typename = void>
+            struct time_store_capacity : public std::integral_constant<size_t, 256> {};
+
+            template <typename TData>
+            struct time_store_capacity<TData, decltype(void(trait::timestamp<TData>::capacity))>
+                : public std::integral_constant<size_t, trait::timestamp<TData>::capacity> {};
+
+            /**
+             * @brief Stores the most recent messages of a type sorted by their timestamp.
+             *
+             * @details
+             *  Every emit of a type that has a trait::timestamp is inserted into a fixed size ring which is kept sorted by
+             *  time. Writers are serialised by a mutex, while readers never lock. Instead they take a sequence number
+             *  before binary searching the ring and retry if a writer changed it while they were reading.
+             *
+             *  The ring only holds indexes into a pool of messages, so the only thing a reader reads outside of the
+             *  sequence check is the message it found. To keep that message alive while it is copied, readers count
+             *  themselves in an epoch, and the writer only reuses an entry that was dropped from the ring once every
+             *  reader that might have seen it has left. The pool has room for twice the ring, so the writer rarely has
+             *  to wait for them.
+             *
+             * @tparam TData the type of the messages that are stored
+             */
+            template <typename TData>
+            class TimeStore {
+            public:
+                /// @brief the number of messages that are kept in the store
+                static constexpr size_t capacity = time_store_capacity<TData>::value;
+
+                static_assert(capacity > 0, "A TimeStore must be able to hold at least one message");
+
+            private:
+                /// @brief Deleted constructor as this class is a static class.
+                TimeStore() = delete;
+                /// @brief Deleted destructor as this class is a static class.
+                ~TimeStore() = delete;
+
+                /// @brief the number of messages we have room for, those in the ring and those waiting on readers
+                static constexpr size_t pool_size = capacity * 2;
+
+                /// @brief serialises the writers to the store
+                static std::mutex mutex;
+                /// @brief incremented before and after each write, odd while a write is in progress
+                static std::atomic<uint64_t> sequence;
+                /// @brief the physical index of the oldest message
+                static std::atomic<size_t> start;
+                /// @brief the number of messages in the store
+                static std::atomic<size_t> count;
+                /// @brief the timestamps of the messages
+                static std::array<std::atomic<clock::rep>, capacity> times;
+                /// @brief the index in the pool of each message
+                static std::array<std::atomic<size_t>, capacity> slots;
+                /// @brief the messages, an entry is only written while it can't be reached by any reader
+                static std::array<std::shared_ptr<const TData>, pool_size> pool;
+
+                /// @brief the current epoch, readers count themselves against its parity while they are reading
+                static std::atomic<uint64_t> epoch;
+                /// @brief the number of readers in the odd and even epochs
+                static std::array<std::atomic<uint64_t>, 2> readers;
+
+                /// @brief the pool entries that are free to use (along with those from fresh onwards)
+                static std::array<size_t, pool_size> unused;
+                /// @brief the number of entries in unused
+                static size_t unusedCount;
+                /// @brief the first pool entry that has never been used
+                static size_t fresh;
+                /// @brief the entries dropped from the ring and the epoch they were dropped in, oldest first
+                static std::array<std::pair<size_t, uint64_t>, pool_size> retired;
+                /// @brief the index of the oldest retired entry
+                static size_t retiredStart;
+                /// @brief the number of retired entries
+                static size_t retiredCount;
+
+                static inline clock::rep time(size_t s, size_t i) {
+                    return times[(s + i) % capacity].load(std::memory_order_relaxed);
+                }
+
+                static inline size_t slot(size_t s, size_t i) {
+                    return slots[(s + i) % capacity].load(std::memory_order_relaxed);
+                }
+
+                /// @brief Waits a little before a reader tries again, yielding to the writer if it is taking a while.
+                static inline void backoff(int& attempts) {
+                    if(++attempts < 16) {
+#if defined(__i386__) || defined(__x86_64__)
+                        __builtin_ia32_pause();
+#endif
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+
+                /// @brief Counts a reader in the current epoch, returning the epoch it must leave.
+                static inline uint64_t enter() {
+                    while(true) {
+                        uint64_t e = epoch.load(std::memory_order_seq_cst);
+                        readers[e & 1].fetch_add(1, std::memory_order_seq_cst);
+
+                        // If the epoch moved on before we were counted the writer may not have seen us
+                        if(epoch.load(std::memory_order_seq_cst) == e) {
+                            return e;
+                        }
+                        readers[e & 1].fetch_sub(1, std::memory_order_relaxed);
+                    }
+                }
+
+                /// @brief Lets the writer know a reader is done with the messages it could see.
+                static inline void leave(uint64_t e) {
+                    readers[e & 1].fetch_sub(1, std::memory_order_release);
+                }
+
+                /**
+                 * @brief Frees the retired entries that no reader can still be using and moves on to a new epoch.
+                 *
+                 * @details
+                 *  Entries retired before the current epoch can only be seen by readers of the previous epoch. Once
+                 *  there are none of those left they can be reused, and the next epoch can reuse that epoch's count.
+                 *  Must be called while holding the mutex.
+                 */
+                static void reclaim() {
+                    uint64_t e = epoch.load(std::memory_order_relaxed);
+
+                    if(readers[(e + 1) & 1].load(std::memory_order_seq_cst) == 0) {
+                        while(retiredCount > 0 && retired[retiredStart].second < e) {
+                            size_t entry = retired[retiredStart].first;
+                            pool[entry].reset();
+                            unused[unusedCount++] = entry;
+                            retiredStart = (retiredStart + 1) % pool_size;
+                            --retiredCount;
+                        }
+
+                        epoch.store(e + 1, std::memory_order_seq_cst);
+                    }
+                }
+
+                /**
+                 * @brief Finds a free pool entry, waiting for readers if they are holding all of the spare ones.
+                 *
+                 * @details
+                 *  Must be called while holding the mutex.
+                 */
+                static size_t allocate() {
+                    while(true) {
+                        if(unusedCount > 0) {
+                            return unused[--unusedCount];
+                        }
+                        if(fresh < pool_size) {
+                            return fresh++;
+                        }
+
+                        // Every spare entry is still waiting on a slow reader
+                        std::this_thread::yield();
+                        reclaim();
+                    }
+                }
+
+            public:
+                /**
+                 * @brief Inserts a message into the store by its timestamp.
+                 *
+                 * @details
+                 *  If the store is full the oldest message is dropped, and messages older than all the stored messages
+                 *  are ignored.
+                 *
+                 * @param d the message to insert
+                 */
+                static void insert(std::shared_ptr<const TData> d) {
+
+                    clock::rep t = trait::timestamp<TData>::get(*d).time_since_epoch().count();
+
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    size_t s = start.load(std::memory_order_relaxed);
+                    size_t n = count.load(std::memory_order_relaxed);
+
+                    // If we are full and this is older than everything we have then there is no room for it
+                    if(n == capacity && t < time(s, 0)) {
+                        return;
+                    }
+
+                    // No reader can reach this entry until it is in the ring
+                    size_t entry = allocate();
+                    pool[entry]  = std::move(d);
+
+                    // Let readers know the store is changing
+                    sequence.fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+
+                    // Drop the oldest message to make room
+                    size_t dropped = pool_size;
+                    if(n == capacity) {
+                        dropped = slot(s, 0);
+                        s = (s + 1) % capacity;
+                        --n;
+                    }
+
+                    // Move any newer messages up one to keep the store sorted (usually there are none)
+                    size_t i = n;
+                    for(; i > 0 && time(s, i - 1) > t; --i) {
+                        times[(s + i) % capacity].store(time(s, i - 1), std::memory_order_relaxed);
+                        slots[(s + i) % capacity].store(slot(s, i - 1), std::memory_order_relaxed);
+                    }
+
+                    times[(s + i) % capacity].store(t, std::memory_order_relaxed);
+                    slots[(s + i) % capacity].store(entry, std::memory_order_relaxed);
+
+                    start.store(s, std::memory_order_relaxed);
+                    count.store(n + 1, std::memory_order_relaxed);
+
+                    // The store is consistent again
+                    sequence.fetch_add(1, std::memory_order_release);
+
+                    // Readers in this epoch may still be copying the message we dropped
+                    if(dropped != pool_size) {
+                        retired[(retiredStart + retiredCount) % pool_size] =
+                            std::make_pair(dropped, epoch.load(std::memory_order_relaxed));
+                        ++retiredCount;
+                    }
+
+                    reclaim();
+                }
+
+                /**
+                 * @brief Finds the message with the timestamp closest to the given time.
+                 *
+                 * @param target the time to search for
+                 *
+                 * @return the closest message, or nullptr if there are no messages stored
+                 */
+                static std::shared_ptr<const TData> nearest(const clock::time_point& target) {
+
+                    clock::rep t = target.time_since_epoch().count();
+
+                    uint64_t e = enter();
+
+                    size_t n     = 0;
+                    size_t entry = 0;
+
+                    for(int attempts = 0;; backoff(attempts)) {
+
+                        uint64_t before = sequence.load(std::memory_order_acquire);
+
+                        // A writer is busy
+                        if(before & 1) {
+                            continue;
+                        }
+
+                        size_t s = start.load(std::memory_order_relaxed);
+                        n        = count.load(std::memory_order_relaxed);
+
+                        if(n > 0) {
+
+                            // Binary search for the first message that is not before our target
+                            size_t lo = 0;
+                            size_t hi = n;
+                            while(lo < hi) {
+                                size_t mid = lo + (hi - lo) / 2;
+                                if(time(s, mid) < t) {
+                                    lo = mid + 1;
+                                }
+                                else {
+                                    hi = mid;
+                                }
+                            }
+
+                            // Pick whichever of the messages either side of the target is closer
+                            size_t index = lo == n ? n - 1
+                                         : lo == 0 ? 0
+                                         : t - time(s, lo - 1) <= time(s, lo) - t ? lo - 1 : lo;
+
+                            entry = slot(s, index);
+                        }
+
+                        // If nothing was written while we were reading then our result is good
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if(sequence.load(std::memory_order_relaxed) == before) {
+                            break;
+                        }
+                    }
+
+                    // The entry was in the ring after we entered our epoch, so it can't be reused until we leave
+                    std::shared_ptr<const TData> result = n > 0 ? pool[entry] : nullptr;
+
+                    leave(e);
+
+                    return result;
+                }
+            };
+
+            template <typename TData>
+            constexpr size_t TimeStore<TData>::capacity;
+            template <typename TData>
+            constexpr size_t TimeStore<TData>::pool_size;
+            template <typename TData>
+            std::mutex TimeStore<TData>::mutex;
+            template <typename TData>
+            std::atomic<uint64_t> TimeStore<TData>::sequence(0);
+            template <typename TData>
+            std::atomic<size_t> TimeStore<TData>::start(0);
+            template <typename TData>
+            std::atomic<size_t> TimeStore<TData>::count(0);
+            template <typename TData>
+            std::array<std::atomic<clock::rep>, TimeStore<TData>::capacity> TimeStore<TData>::times;
+            template <typename TData>
+            std::array<std::atomic<size_t>, TimeStore<TData>::capacity> TimeStore<TData>::slots;
+            template <typename TData>
+            std::array<std::shared_ptr<const TData>, TimeStore<TData>::pool_size> TimeStore<TData>::pool;
+            template <typename TData>
+            std::atomic<uint64_t> TimeStore<TData>::epoch(0);
+            template <typename TData>
+            std::array<std::atomic<uint64_t>, 2> TimeStore<TData>::readers;
+            template <typename TData>
+            std::array<size_t, TimeStore<TData>::pool_size> TimeStore<TData>::unused;
+            template <typename TData>
+            size_t TimeStore<TData>::unusedCount = 0;
+            template <typename TData>
+            size_t TimeStore<TData>::fresh = 0;
+            template <typename TData>
+            std::array<std::pair<size_t, uint64_t>, TimeStore<TData>::pool_size> TimeStore<TData>::retired;
+            template <typename TData>
+            size_t TimeStore<TData>::retiredStart = 0;
+            template <typename TData>
+            size_t TimeStore<TData>::retiredCount = 0;
+
+            /**
+             * @brief Stores an emitted message by time if its type has a timestamp, otherwise does nothing.
+             *
+             * @param d the message that was emitted
+             */
+            template <typename TData>
+            inline std::enable_if_t<!trait::timestamp<TData>::value> record_time(const std::shared_ptr<TData>&) {}
+
+            template <typename TData>
+            inline std::enable_if_t<trait::timestamp<TData>::value> record_time(const std::shared_ptr<TData>& d) {
+                TimeStore<TData>::insert(d);
+            }
+
+        }  // namespace store
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_STORE_TIMESTORE_HPP
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_TRAIT_TIMESTAMP_HPP
+#define NUCLEAR_DSL_TRAIT_TIMESTAMP_HPP
+
+#include <type_traits>
+
+#include "nuclear_bits/clock.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace trait {
+
+            /**
+             * @brief Describes how to get the time a message was created.
+             *
+             * @details
+             *  Types that specialise this trait (inheriting from std::true_type) have every emit stored by time so they
+             *  can be found using WithNearest. The specialisation must provide a static get function that returns the
+             *  timestamp of a message.
+             *  @code
+             *  template <>
+             *  struct timestamp<IMU> : public std::true_type {
+             *      static NUClear::clock::time_point get(const IMU& imu) { return imu.timestamp; }
+             *  };
+             *  @endcode
+             *  Messages are expected to be emitted roughly in time order. The most recent 256 messages are kept to search
+             *  through, a specialisation can keep a different number by also providing a capacity.
+             *  @code
+             *  template <>
+             *  struct timestamp<IMU> : public std::true_type {
+             *      static constexpr size_t capacity = 1024;
+             *      static NUClear::clock::time_point get(const IMU& imu) { return imu.timestamp; }
+             *  };
+             *  @endcode
+             */
+            template <typename>
+            struct timestamp : public std::false_type {};
+
+        }  // namespace trait
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_TRAIT_TIMESTAMP_HPP
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_WORD_BATCH_HPP
+#define NUCLEAR_DSL_WORD_BATCH_HPP
+
+#include <memory>
+#include <vector>
+
+namespace NUClear {
+    namespace dsl {
+        namespace word {
+
+            /**
+             * @ingroup SmartTypes
+             * @brief This type holds every element of a batch emit so it can be handled in a single task.
+             *
+             * @details
+             *  When a vector of data is emitted, each element will trigger the reactions for its type individually. A
+             *  reaction that would rather process the whole batch at once can instead trigger on this type.
+             *  @code on<Trigger<Batch<T>>>() @endcode
+             *  It will then run once per batch emit, with all of the elements in the order they were emitted. Note that
+             *  individual emits of T will not trigger reactions on Batch<T>.
+             *
+             * @tparam TData the datatype of the elements in the batch
+             */
+            template <typename TData>
+            struct Batch : public std::vector<std::shared_ptr<const TData>> {
+                // Inherit constructors
+                using std::vector<std::shared_ptr<const TData>>::vector;
+            };
+
+        }  // namespace word
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_WORD_BATCH_HPP
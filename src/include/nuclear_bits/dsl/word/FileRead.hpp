@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_WORD_FILEREAD_HPP
+#define NUCLEAR_DSL_WORD_FILEREAD_HPP
+
+#include "nuclear_bits/dsl/operation/Unbind.hpp"
+#include "nuclear_bits/dsl/word/emit/Direct.hpp"
+#include "nuclear_bits/dsl/store/ThreadStore.hpp"
+#include "nuclear_bits/util/generate_reaction.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace word {
+
+            struct FileReadConfiguration {
+                std::string path;
+                std::shared_ptr<threading::Reaction> reaction;
+            };
+
+            /**
+             * @ingroup SmartTypes
+             * @brief This is used to read a file without blocking a pool thread
+             *
+             * @details
+             *  @code on<FileRead>(path) @endcode
+             *  The file is read by the file controller's thread, and once it has been read the reaction runs once with
+             *  its contents. Any writes to the file that were emitted with Scope::FILE before the reaction was bound
+             *  will have been made before it is read.
+             */
+            struct FileRead {
+
+                /// @brief the contents of a file that was read
+                struct Contents {
+                    Contents() : path(""), data(), error(0) {}
+
+                    /// @brief the path of the file that was read
+                    std::string path;
+                    /// @brief the contents of the file
+                    std::vector<char> data;
+                    /// @brief the error number if the file couldn't be read, otherwise 0
+                    int error;
+
+                    operator bool() const {
+                        return !path.empty();
+                    }
+                };
+
+                using ThreadContentsStore = dsl::store::ThreadStore<Contents>;
+
+                template <typename DSL, typename TFunc>
+                static inline threading::ReactionHandle bind(Reactor& reactor, const std::string& label, TFunc&& callback, const std::string& path) {
+
+                    auto config = std::make_unique<FileReadConfiguration>(FileReadConfiguration {
+                        path,
+                        util::generate_reaction<DSL, FileRead>(reactor, label, std::forward<TFunc>(callback))
+                    });
+
+                    threading::ReactionHandle handle(config->reaction);
+
+                    // Send our configuration out
+                    reactor.powerplant.emit<emit::Direct>(config);
+
+                    // Return our handles
+                    return handle;
+                }
+
+                template <typename DSL>
+                static inline Contents get(threading::Reaction&) {
+
+                    // If our thread store has a value take it, otherwise return invalid contents
+                    if(ThreadContentsStore::value) {
+                        return std::move(*ThreadContentsStore::value);
+                    }
+                    else {
+                        return Contents();
+                    }
+                }
+            };
+
+        }  // namespace word
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_WORD_FILEREAD_HPP
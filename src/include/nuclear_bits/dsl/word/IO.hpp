@@ -22,13 +22,18 @@
     #include "nuclear_bits/util/windows_includes.hpp"
 #else
     #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
 #endif
 
+#include <functional>
+
 #include "nuclear_bits/dsl/operation/Unbind.hpp"
 #include "nuclear_bits/dsl/word/emit/Direct.hpp"
 #include "nuclear_bits/dsl/word/Single.hpp"
 #include "nuclear_bits/dsl/store/ThreadStore.hpp"
 #include "nuclear_bits/dsl/trait/is_transient.hpp"
+#include "nuclear_bits/util/BufferPool.hpp"
 #include "nuclear_bits/util/generate_reaction.hpp"
 #include "nuclear_bits/util/platform.hpp"
 
@@ -40,9 +45,24 @@ namespace NUClear {
                 fd_t fd;
                 int events;
                 std::shared_ptr<threading::Reaction> reaction;
+                /// @brief if the controller is told when the reaction's tasks finish, so it isn't watched while they run
+                bool oneShot = false;
+                /// @brief if the reaction gets all of the events from one wait of the controller in a single task
+                bool batch = false;
+                /// @brief if the controller keeps making tasks for an event while the get says it has more to give
+                bool drain = false;
             };
 
-            // IO is implicitly single
+            /**
+             * @ingroup SmartTypes
+             * @brief This is used to request reactions when a file descriptor is ready for reading or writing
+             *
+             * @details
+             *  IO is implicitly single. Once an event has been handed to a reaction, the controller stops watching
+             *  for that reaction's events until its task has finished, so a file descriptor that is still ready while
+             *  the task runs doesn't wake the controller over and over again. Words such as UDP and TCP that read
+             *  their data while the task is being made don't need this and are watched the whole time.
+             */
             struct IO : public Single {
 
                 // On windows we use different wait events
@@ -71,7 +91,46 @@ namespace NUClear {
                     }
                 };
 
+                /// @brief the events that were ready for a batch reaction
+                struct Events : public std::vector<Event> {
+
+                    operator bool() const {
+                        return !empty();
+                    }
+                };
+
+                /// @brief the data that was read from a file descriptor for a receive reaction
+                struct Received {
+                    Received() : fd(-1), events(0), data() {}
+
+                    /// @brief the file descriptor the data was read from
+                    fd_t fd;
+                    /// @brief the events that happened, CLOSE or ERROR are added if the read found them
+                    int events;
+                    /// @brief the data that was read, this is empty if the file descriptor was closed or had an error
+                    util::BufferPool::Buffer data;
+
+                    operator bool() const {
+                        return fd != -1;
+                    }
+                };
+
+                /// @brief the size of the largest buffers in the pool, which is big enough for any datagram
+                static constexpr size_t BUFFER_SIZE = 65536;
+
+                /// @brief the pool that words read data into, it is never destroyed so buffers can outlive us
+                static inline util::BufferPool& pool() {
+                    static util::BufferPool* p = new util::BufferPool(BUFFER_SIZE);
+                    return *p;
+                }
+
                 using ThreadEventStore = dsl::store::ThreadStore<Event>;
+                using ThreadEventsStore = dsl::store::ThreadStore<Events>;
+                /// @brief set by gets that read more than they returned, so a draining controller asks them again
+                using ThreadDrainStore = dsl::store::ThreadStore<bool>;
+
+                struct Batch;
+                struct Receive;
 
                 template <typename DSL, typename TFunc>
                 static inline threading::ReactionHandle bind(Reactor& reactor, const std::string& label, TFunc&& callback, fd_t fd, int watchSet) {
@@ -81,7 +140,8 @@ namespace NUClear {
                     auto ioConfig = std::make_unique<IOConfiguration>(IOConfiguration {
                         fd,
                         watchSet,
-                        std::move(reaction)
+                        std::move(reaction),
+                        true
                     });
 
                     threading::ReactionHandle handle(ioConfig->reaction);
@@ -105,6 +165,153 @@ namespace NUClear {
                         return Event { -1, 0 };
                     }
                 }
+
+                /**
+                 * @brief Called with the id of a reaction when one of its tasks has finished.
+                 *
+                 * @details
+                 *  This is set by the IO controller so it can watch the reaction's file descriptors again. It is called
+                 *  directly from the postcondition, which runs once the task no longer counts as active, so a Single
+                 *  precondition won't reject the next event.
+                 */
+                static inline std::function<void (uint64_t)>& finished() {
+                    static std::function<void (uint64_t)> f;
+                    return f;
+                }
+
+                template <typename DSL>
+                static inline void postcondition(threading::ReactionTask& task) {
+
+                    // Let the controller know it can watch for our events again
+                    auto& f = finished();
+                    if(f) {
+                        f(task.parent.reactionId);
+                    }
+                }
+            };
+
+            /**
+             * @ingroup SmartTypes
+             * @brief This is used to handle the events of many file descriptors together
+             *
+             * @details
+             *  @code on<IO::Batch>(fds, IO::READ) @endcode
+             *  Watches every file descriptor in fds. Rather than making a task for each one that is ready, the
+             *  controller gathers all of the events it finds for the reaction in one wait and makes a single task for
+             *  them, which gets them as an IO::Events. A busy reaction then costs a task per wait rather than a task
+             *  per ready file descriptor. Like IO it is single, and is not watched while its task is running.
+             *
+             *  When there are several IO threads, all of the file descriptors of a batch are watched by the same one.
+             */
+            struct IO::Batch : public IO {
+
+                template <typename DSL, typename TFunc>
+                static inline threading::ReactionHandle bind(Reactor& reactor, const std::string& label, TFunc&& callback, const std::vector<fd_t>& fds, int watchSet) {
+
+                    // We unbind like any other IO reaction
+                    std::shared_ptr<threading::Reaction> reaction = util::generate_reaction<DSL, IO>(reactor, label, std::forward<TFunc>(callback));
+                    threading::ReactionHandle handle(reaction);
+
+                    // Send a configuration for each of our file descriptors
+                    for(const auto& fd : fds) {
+                        reactor.powerplant.emit<emit::Direct>(std::make_unique<IOConfiguration>(IOConfiguration {
+                            fd,
+                            watchSet,
+                            reaction,
+                            true,
+                            true
+                        }));
+                    }
+
+                    // Return our handles
+                    return handle;
+                }
+
+                template <typename DSL>
+                static inline Events get(threading::Reaction&) {
+
+                    // If our thread store has a value take it, otherwise return no events
+                    if(ThreadEventsStore::value) {
+                        return std::move(*ThreadEventsStore::value);
+                    }
+                    else {
+                        return Events();
+                    }
+                }
+            };
+
+            /**
+             * @ingroup SmartTypes
+             * @brief This is used to have the controller read the data from a file descriptor
+             *
+             * @details
+             *  @code on<IO::Receive>(fd) @endcode
+             *  When the file descriptor is readable, the data is read on the IO thread into a buffer from a shared pool
+             *  and the reaction gets it as an IO::Received. The buffer goes back to the pool when the last copy of it
+             *  is gone, so once the pool has enough buffers reading doesn't allocate. The buffer is sized to the data
+             *  that is waiting (FIONREAD), so a small read doesn't hold on to a large buffer. Each read gets at most
+             *  BUFFER_SIZE bytes, so for a datagram socket this is one datagram. Like IO it is single, and nothing is
+             *  read while its task is running.
+             */
+            struct IO::Receive : public IO {
+
+                template <typename DSL, typename TFunc>
+                static inline threading::ReactionHandle bind(Reactor& reactor, const std::string& label, TFunc&& callback, fd_t fd) {
+                    // We also want to know when it closes or errors so the read can report it
+                    return IO::bind<DSL>(reactor, label, std::forward<TFunc>(callback), fd, IO::READ | IO::CLOSE | IO::ERROR);
+                }
+
+                template <typename DSL>
+                static inline Received get(threading::Reaction& r) {
+
+                    // If we weren't triggered by an event there is nothing to read
+                    Received received;
+                    auto event = IO::get<DSL>(r);
+                    if(!event) {
+                        return received;
+                    }
+
+                    // Only take as big a buffer as we need for what is waiting, if we can't tell we take the biggest
+                    #ifdef _WIN32
+                    u_long waiting = 0;
+                    if(::ioctlsocket(event.fd, FIONREAD, &waiting) != 0) {
+                        waiting = BUFFER_SIZE;
+                    }
+                    #else
+                    int waiting = 0;
+                    if(::ioctl(event.fd, FIONREAD, &waiting) != 0 || waiting < 0) {
+                        waiting = BUFFER_SIZE;
+                    }
+                    #endif
+                    received.data = pool().acquire(size_t(waiting));
+
+                    #ifdef _WIN32
+                    auto bytes = ::recv(event.fd, received.data.data(), int(received.data.capacity()), 0);
+                    #else
+                    auto bytes = ::read(event.fd, received.data.data(), received.data.capacity());
+                    #endif
+
+                    if(bytes < 0) {
+                        // Something else got there first so there is nothing to run with
+                        #ifdef _WIN32
+                        if(network_errno == WSAEWOULDBLOCK) {
+                        #else
+                        if(network_errno == EAGAIN || network_errno == EWOULDBLOCK) {
+                        #endif
+                            return received;
+                        }
+                        event.events |= IO::ERROR;
+                        bytes = 0;
+                    }
+                    else if(bytes == 0) {
+                        event.events |= IO::CLOSE;
+                    }
+
+                    received.fd = event.fd;
+                    received.events = event.events;
+                    received.data.resize(size_t(bytes));
+                    return received;
+                }
             };
 
         }  // namespace word
@@ -18,23 +18,69 @@
 #ifndef NUCLEAR_DSL_WORD_LAST_HPP
 #define NUCLEAR_DSL_WORD_LAST_HPP
 
-#include <type_traits>
+#include <algorithm>
 #include <list>
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include "nuclear_bits/util/MergeTransient.hpp"
 
 namespace NUClear {
     namespace dsl {
         namespace word {
 
+            /**
+             * @brief Holds the history of the last len items for a Last word.
+             *
+             * @details
+             *  The items are kept in an append only buffer that is shared between the transient storage and every task
+             *  that has been created from it. Each task only holds a view (the end index and size) into the buffer, so
+             *  creating a task does not need to copy the history. Once the buffer is full a new one is started with the
+             *  items that are still needed, and any existing tasks keep the old buffer alive until they are finished.
+             *
+             * @tparam len   the number of items to keep in the history
+             * @tparam TData the type of the items that are stored
+             */
             template<size_t len, typename TData>
             struct LastItemStorage {
-                // The items we are storing
-                std::list<TData> list;
+                static_assert(len > 0, "Last must keep at least one item");
+
+                // The newest item that was bound before it has been merged into the history
+                TData item;
+                // The buffer the history is stored in
+                std::shared_ptr<std::vector<TData>> buffer;
+                // One past the newest item in our view of the buffer
+                size_t end;
+                // How many items are in our view of the buffer
+                size_t size;
+
+                LastItemStorage() : item(), buffer(), end(0), size(0) {
+                }
 
-                LastItemStorage() : list() {
+                LastItemStorage(TData&& data) : item(std::move(data)), buffer(), end(0), size(0) {
                 }
 
-                LastItemStorage(TData&& data) : list({data}) {
+                void push(TData&& data) {
+
+                    // If we have run out of room start a new buffer with the items we still need
+                    if(!buffer || buffer->size() == buffer->capacity()) {
+                        auto next = std::make_shared<std::vector<TData>>();
+                        next->reserve(2 * len);
+
+                        size_t keep = std::min(size, len - 1);
+                        if(keep > 0) {
+                            next->insert(next->end(), std::next(buffer->begin(), end - keep), std::next(buffer->begin(), end));
+                        }
+
+                        buffer = std::move(next);
+                        end = keep;
+                        size = keep;
+                    }
+
+                    // Append our new item, this never moves the existing items so other views remain valid
+                    buffer->push_back(std::move(data));
+                    ++end;
+                    size = std::min(size + 1, len);
                 }
 
                 template <typename TOutput>
@@ -42,8 +88,8 @@ namespace NUClear {
 
                     std::list<TOutput> out;
 
-                    for(const TData& item : list) {
-                        out.push_back(TOutput(item));
+                    for(size_t i = end - size; i < end; ++i) {
+                        out.push_back(TOutput((*buffer)[i]));
                     }
 
                     return out;
@@ -53,16 +99,17 @@ namespace NUClear {
                 operator std::vector<TOutput>() const {
 
                     std::vector<TOutput> out;
+                    out.reserve(size);
 
-                    for(const TData& item : list) {
-                        out.push_back(TOutput(item));
+                    for(size_t i = end - size; i < end; ++i) {
+                        out.push_back(TOutput((*buffer)[i]));
                     }
 
                     return out;
                 }
 
                 operator bool() const {
-                    return !list.empty();
+                    return size > 0;
                 }
             };
 
@@ -102,17 +149,13 @@ namespace NUClear {
         struct MergeTransients<dsl::word::LastItemStorage<len, T>> {
             static inline bool merge(dsl::word::LastItemStorage<len, T>& t, dsl::word::LastItemStorage<len, T>& d) {
 
-                // We put the contents from data into the transient storage list
-                t.list.insert(t.list.end(), d.list.begin(), d.list.end());
-
-                // Then truncate the old transient data
-                if(t.list.size() > len) {
-                    t.list.erase(t.list.begin(), std::next(t.list.begin(), t.list.size() - len));
-                }
+                // We add the new item from data onto the end of the transient history
+                t.push(std::move(d.item));
 
-                // Finally clear the data list and put the transient list in it
-                d.list.clear();
-                d.list.insert(d.list.begin(), t.list.begin(), t.list.end());
+                // Then give the data a view of the transient history
+                d.buffer = t.buffer;
+                d.end = t.end;
+                d.size = t.size;
 
                 return true;
             };
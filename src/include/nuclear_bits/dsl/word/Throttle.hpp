@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NUCLEAR_DSL_WORD_THROTTLE_HPP
+#define NUCLEAR_DSL_WORD_THROTTLE_HPP
+
+#include <algorithm>
+
+#include "nuclear_bits/clock.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace word {
+
+            /**
+             * @ingroup Options
+             * @brief This option limits how often a reaction can run to N times per period
+             *
+             * @details
+             *  Each reaction with this option has a token bucket that holds up to N tokens and refills at N tokens per
+             *  period. Creating a task takes a token, and if the bucket is empty the trigger is ignored before any
+             *  data is bound or a task is made. This allows bursts of up to N tasks, while over a long time the
+             *  reaction will run at most N times per period. The number of ignored triggers is counted, and can be
+             *  read from the ReactionHandle (in total) or in ReactionHistogramSnapshot (for each interval).
+             *
+             *  The bucket is a single atomic time per reaction (the time it will next be full) so it does not lock.
+             *
+             *  A token is taken as soon as this precondition passes, so if other preconditions may reject the task
+             *  this should be placed after them in the on statement.
+             *
+             * @tparam N      the number of tasks that can be made per period
+             * @tparam period the period that N tasks can be made in
+             */
+            template <int N, typename period = std::chrono::seconds>
+            struct Throttle {
+                static_assert(N > 0, "A Throttle must allow at least one task per period");
+
+                template <typename DSL>
+                static inline bool precondition(threading::Reaction& reaction) {
+
+                    // How often we gain a new token, and how far the bucket can be behind now while holding one
+                    const clock::rep interval = std::chrono::duration_cast<clock::duration>(period(1)).count() / N;
+                    const clock::rep burst    = interval * (N - 1);
+
+                    clock::rep now  = clock::now().time_since_epoch().count();
+                    clock::rep full = reaction.throttleTime.load(std::memory_order_relaxed);
+
+                    do {
+                        // If we would have to go past our burst to take a token, the bucket is empty
+                        if (full - now > burst) {
+                            reaction.throttled.fetch_add(1, std::memory_order_relaxed);
+                            reaction.throttledInterval.fetch_add(1, std::memory_order_relaxed);
+                            return false;
+                        }
+                    } while (!reaction.throttleTime.compare_exchange_weak(full, std::max(full, now) + interval, std::memory_order_relaxed));
+
+                    return true;
+                }
+            };
+
+        }  // namespace word
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_WORD_THROTTLE_HPP
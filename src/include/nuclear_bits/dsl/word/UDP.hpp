@@ -30,8 +30,28 @@
     #include <cstring>
 #endif
 
+#ifdef __linux__
+    #include <netinet/udp.h>
+
+    // Older headers don't know about UDP segmentation offload even when the kernel does
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103
+    #endif
+    #ifndef UDP_GRO
+        #define UDP_GRO 104
+    #endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include "nuclear_bits/PowerPlant.hpp"
+#include "nuclear_bits/dsl/fusion/has_precondition.hpp"
 #include "nuclear_bits/dsl/word/IO.hpp"
+#include "nuclear_bits/util/BufferPool.hpp"
 #include "nuclear_bits/util/generate_reaction.hpp"
 #include "nuclear_bits/util/FileDescriptor.hpp"
 #include "nuclear_bits/util/network/get_interfaces.hpp"
@@ -70,8 +90,8 @@ namespace NUClear {
                         uint16_t port;
                     } local;
 
-                    /// The data to be sent in the packet
-                    std::vector<char> data;
+                    /// The data in the packet, a buffer from the IO pool that goes back to it once every copy is gone
+                    util::BufferPool::Buffer data;
 
                     /// Our validator when returned for if we are a real packet
                     operator bool() const {
@@ -120,9 +140,13 @@ namespace NUClear {
                     }
                     port = ntohs(address.sin_port);
 
+                    // Remember our port so we don't have to look it up for every packet
+                    sockets().add(fd, port);
+
                     // Generate a reaction for the IO system that closes on death
                     int cfd = fd;
                     auto reaction = util::generate_reaction<DSL, IO>(reactor, label, std::forward<TFunc>(callback), [cfd] (threading::Reaction&) {
+                        sockets().remove(cfd);
                         close(cfd);
                     });
 
@@ -132,6 +156,9 @@ namespace NUClear {
                         std::move(reaction)
                     });
 
+                    // Each event gets a packet for everything that was waiting on the socket
+                    ioConfig->drain = true;
+
                     threading::ReactionHandle handle(ioConfig->reaction);
 
                     // Send our configuration out
@@ -141,85 +168,338 @@ namespace NUClear {
                     return std::make_tuple(handle, port, cfd);
                 }
 
-                template <typename DSL>
-                static inline Packet get(threading::Reaction& r) {
+                /// @brief the most packets a single receive reads from a socket
+                #ifdef __linux__
+                static constexpr int RECEIVE_BATCH = 32;
+                #else
+                static constexpr int RECEIVE_BATCH = 1;
+                #endif
+
+                /// @brief the largest packet we receive (hopefully packets are smaller then this as most MTUs are around 1500)
+                static constexpr size_t PACKET_SIZE = 2048;
+
+                /**
+                 * @brief Reads a batch of packets from a socket into buffers from the IO pool.
+                 *
+                 * @details
+                 *  Each socket we bind has one of these. When the socket is ready it is read with a single recvmmsg
+                 *  call (recvmsg where that isn't available) and then the packets are handed out one at a time by the
+                 *  get, which tells the controller to keep asking until they are all gone. Anything the controller
+                 *  doesn't ask for stays here and is handed out first the next time the socket is ready. Sockets that
+                 *  use GRO are read into a single buffer that is big enough for a whole joined packet, which is then
+                 *  split apart.
+                 *
+                 *  Each packet references the buffer it was read into rather than being copied out of it. A buffer is
+                 *  read into again if all the packets from it are gone by the next read, otherwise it is replaced with
+                 *  another from the pool.
+                 */
+                struct Receiver {
+                    /// @brief a single packet in one of our buffers
+                    struct Segment {
+                        int slot;
+                        size_t offset;
+                        size_t length;
+                    };
+
+                    Receiver(in_port_t port)
+                    : mutex()
+                    , port(port)
+                    , gro(false)
+                    , next(0)
+                    , segments()
+                    , buffers()
+                    , control()
+                    , from()
+                    , local()
+                    , payloads()
+                    #ifdef __linux__
+                    , messages() {
+                    #else
+                    , headers() {
+                    #endif
+                    }
 
-                    // Get our filedescriptor from the magic cache
-                    auto event = IO::get<DSL>(r);
+                    /// @brief the header for the packet in a slot
+                    msghdr& header(int i) {
+                        #ifdef __linux__
+                        return messages[i].msg_hdr;
+                        #else
+                        return headers[i];
+                        #endif
+                    }
+
+                    /// @brief read as many packets as are waiting (up to limit) from the socket
+                    void receive(fd_t socket, int limit) {
+
+                        next = 0;
+                        segments.clear();
+
+                        // Our storage is only made once we are first used
+                        if (buffers.empty()) {
+                            buffers.resize(RECEIVE_BATCH);
+                            control.resize(RECEIVE_BATCH * 0x100);
+                            from.resize(RECEIVE_BATCH);
+                            local.resize(RECEIVE_BATCH);
+                            payloads.resize(RECEIVE_BATCH);
+                            #ifdef __linux__
+                            messages.resize(RECEIVE_BATCH);
+                            #else
+                            headers.resize(RECEIVE_BATCH);
+                            #endif
+                        }
+
+                        // Joined packets can be as big as a UDP packet can be so they get the biggest buffer
+                        int slots = gro ? 1 : limit < RECEIVE_BATCH ? limit : RECEIVE_BATCH;
+                        size_t size = gro ? IO::BUFFER_SIZE : PACKET_SIZE;
+
+                        // The kernel changes the lengths in our headers, so they are reset every time
+                        for(int i = 0; i < slots; ++i) {
+
+                            // We can only read into a buffer again if none of the packets we handed out are using it
+                            if(!buffers[i].unique() || buffers[i].capacity() < size) {
+                                buffers[i] = IO::pool().acquire(size);
+                            }
+
+                            payloads[i].iov_base = buffers[i].data();
+                            payloads[i].iov_len = size;
+
+                            msghdr& mh = header(i);
+                            memset(&mh, 0, sizeof(msghdr));
+                            mh.msg_name = reinterpret_cast<sockaddr*>(&from[i]);
+                            mh.msg_namelen = sizeof(sockaddr_in);
+                            mh.msg_control = control.data() + i * 0x100;
+                            mh.msg_controllen = 0x100;
+                            mh.msg_iov = &payloads[i];
+                            mh.msg_iovlen = 1;
+                        }
+
+                        #ifdef __linux__
+                        // We know at least one packet is waiting so don't wait around for any more
+                        int count = recvmmsg(socket, messages.data(), slots, MSG_DONTWAIT, nullptr);
+                        #else
+                        ssize_t received = recvmsg(socket, &header(0), 0);
+                        int count = received > 0 ? 1 : 0;
+                        #endif
+
+                        for(int i = 0; i < count; ++i) {
+
+                            #ifdef __linux__
+                            size_t length = messages[i].msg_len;
+                            #else
+                            size_t length = size_t(received);
+                            #endif
+
+                            // Iterate through control headers to get IP information, and how big joined packets are
+                            msghdr& mh = header(i);
+                            size_t segmentSize = length;
+                            local[i] = 0;
+                            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&mh);
+                                 cmsg != nullptr;
+                                 cmsg = CMSG_NXTHDR(&mh, cmsg)) {
+
+                                if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+
+                                    // Access the packet header information
+                                    in_pktinfo* pi = reinterpret_cast<in_pktinfo*>(reinterpret_cast<char*>(cmsg) + sizeof(*cmsg));
+                                    local[i] = pi->ipi_addr.s_addr;
+                                }
+                                #ifdef __linux__
+                                else if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                                    int gso;
+                                    std::memcpy(&gso, CMSG_DATA(cmsg), sizeof(int));
+                                    if (gso > 0) {
+                                        segmentSize = size_t(gso);
+                                    }
+                                }
+                                #endif
+                            }
+
+                            // Every joined packet is the same size except for the last one
+                            for (size_t offset = 0; offset < length; offset += segmentSize) {
+                                segments.push_back(Segment { i, offset, std::min(segmentSize, length - offset) });
+                            }
+                        }
+                    }
+
+                    /// @brief if we have packets left to hand out
+                    bool empty() const {
+                        return next == segments.size();
+                    }
+
+                    /// @brief make a packet out of the next one we are holding
+                    Packet pop() {
+
+                        const Segment& s = segments[next++];
 
-                    // If our get is being run without an fd (something else triggered) then short circuit
-                    if (event.fd == 0) {
                         Packet p;
-                        p.remote.address = INADDR_NONE;
-                        p.remote.port = 0;
-                        p.local.address = INADDR_NONE;
-                        p.local.port = 0;
-                        p.valid = false;
+                        p.valid = true;
+                        p.remote.address = ntohl(from[s.slot].sin_addr.s_addr);
+                        p.remote.port = ntohs(from[s.slot].sin_port);
+                        p.local.address = ntohl(local[s.slot]);
+                        p.local.port = port;
+
+                        // The packet shares the part of our buffer it was read into
+                        p.data = buffers[s.slot].slice(s.offset, s.length);
+
                         return p;
                     }
 
-                    // Make a packet with 2k of storage (hopefully packets are smaller then this as most MTUs are around 1500)
+                    /// @brief held while reading the socket or handing out its packets
+                    std::mutex mutex;
+                    /// @brief the port the socket is listening on
+                    in_port_t port;
+                    /// @brief if the kernel can give us several packets from the socket joined together
+                    bool gro;
+                    /// @brief the next packet to hand out
+                    size_t next;
+                    /// @brief the packets we are holding
+                    std::vector<Segment> segments;
+
+                    /// @brief the buffer each packet in a batch is read into
+                    std::vector<util::BufferPool::Buffer> buffers;
+                    std::vector<char> control;
+                    std::vector<sockaddr_in> from;
+                    std::vector<in_addr_t> local;
+                    std::vector<iovec> payloads;
+                    #ifdef __linux__
+                    std::vector<mmsghdr> messages;
+                    #else
+                    std::vector<msghdr> headers;
+                    #endif
+                };
+
+                /**
+                 * @brief The receivers for the sockets we bound, so packets from one are never lost to another.
+                 *
+                 * @details
+                 *  Sockets are rarely added or removed, but are looked up for every packet. So each thread keeps its
+                 *  own copy of the receivers, and only takes the lock to copy them again once they have changed.
+                 */
+                struct Sockets {
+
+                    Sockets() : mutex(), receivers(), generation(0) {}
+
+                    std::mutex mutex;
+                    std::map<fd_t, std::shared_ptr<Receiver>> receivers;
+                    /// @brief changed every time a socket is added or removed
+                    std::atomic<uint64_t> generation;
+
+                    void add(fd_t fd, in_port_t port) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        receivers[fd] = std::make_shared<Receiver>(port);
+                        generation.fetch_add(1, std::memory_order_release);
+                    }
+
+                    void remove(fd_t fd) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        receivers.erase(fd);
+                        generation.fetch_add(1, std::memory_order_release);
+                    }
+
+                    /// @brief finds the receiver for a socket, it stays alive until this thread looks for one again
+                    Receiver* find(fd_t fd) {
+
+                        static thread_local std::pair<uint64_t, std::map<fd_t, std::shared_ptr<Receiver>>> local;
+
+                        if(local.first != generation.load(std::memory_order_acquire)) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            local.second = receivers;
+                            local.first = generation.load(std::memory_order_relaxed);
+                        }
+
+                        auto it = local.second.find(fd);
+                        return it == local.second.end() ? nullptr : it->second.get();
+                    }
+                };
+
+                /// @brief the sockets we have bound, this is never destroyed so sockets can be closed after us
+                static inline Sockets& sockets() {
+                    static Sockets* s = new Sockets();
+                    return *s;
+                }
+
+                /**
+                 * @brief Lets the kernel join packets from a socket together (UDP_GRO) so they can be read at once.
+                 *
+                 * @details
+                 *  The joined packets are split apart again when they are received, so each one still gets its own
+                 *  task. This only works on Linux kernels that support it. A joined packet is always read whole, so a
+                 *  reaction with a precondition (such as Single) may only run for part of it, the rest is handed out
+                 *  the next time the socket is ready.
+                 *
+                 * @param fd the socket to enable it for, this must have been bound by a UDP reaction
+                 *
+                 * @return if the kernel will join packets for this socket
+                 */
+                static inline bool enableGRO(fd_t fd) {
+                    #if defined(__linux__)
+                    auto receiver = sockets().find(fd);
+                    int yes = 1;
+                    if(receiver && setsockopt(fd, SOL_UDP, UDP_GRO, &yes, sizeof(yes)) == 0) {
+                        std::lock_guard<std::mutex> lock(receiver->mutex);
+                        receiver->gro = true;
+                        return true;
+                    }
+                    #else
+                    (void) fd;
+                    #endif
+                    return false;
+                }
+
+                template <typename DSL>
+                static inline Packet get(threading::Reaction& r) {
+
+                    // Get our filedescriptor from the magic cache
+                    auto event = IO::get<DSL>(r);
+
+                    // An invalid packet for when we have nothing
                     Packet p;
                     p.remote.address = INADDR_NONE;
                     p.remote.port = 0;
                     p.local.address = INADDR_NONE;
                     p.local.port = 0;
                     p.valid = false;
-                    p.data.resize(2048);
-
-                    // Make some variables to hold our message header information
-                    char cmbuff[0x100] = { 0 };
-                    sockaddr_in from;
-                    memset(&from, 0, sizeof(sockaddr_in));
-                    iovec payload;
-                    payload.iov_base = p.data.data();
-                    payload.iov_len = p.data.size();
-
-                    // Make our message header to receive with
-                    msghdr mh;
-                    memset(&mh, 0, sizeof(msghdr));
-                    mh.msg_name = reinterpret_cast<sockaddr*>(&from);
-                    mh.msg_namelen = sizeof(sockaddr_in);
-                    mh.msg_control = cmbuff;
-                    mh.msg_controllen = sizeof(cmbuff);
-                    mh.msg_iov = &payload;
-                    mh.msg_iovlen = 1;
-
-                    // Receive our message
-                    ssize_t received = recvmsg(event.fd, &mh, 0);
-
-                    // Iterate through control headers to get IP information
-                    in_addr_t ourAddr = 0;
-                    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&mh);
-                         cmsg != nullptr;
-                         cmsg = CMSG_NXTHDR(&mh, cmsg)) {
-                        // ignore the control headers that don't match what we want
-                        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
-
-                            // Access the packet header information
-                            in_pktinfo* pi = reinterpret_cast<in_pktinfo*>(reinterpret_cast<char*>(cmsg) + sizeof(*cmsg));
-                            ourAddr = pi->ipi_addr.s_addr;
-
-                            // We are done
-                            break;
+
+                    // If our get is being run without an fd (something else triggered) then short circuit
+                    if (!event) {
+                        return p;
+                    }
+
+                    // A precondition can stop the controller asking for the rest of a batch, so if there is one we only
+                    // read a single packet and leave the rest in the socket where they will wake us again
+                    constexpr int limit = fusion::has_precondition<typename DSL::DSL>::value ? 1 : RECEIVE_BATCH;
+
+                    Receiver* receiver = sockets().find(event.fd);
+
+                    // This socket wasn't bound by us so we have to ask what port it is on
+                    if (!receiver) {
+                        sockaddr_in address;
+                        socklen_t len = sizeof(sockaddr_in);
+                        if (::getsockname(event.fd, reinterpret_cast<sockaddr*>(&address), &len) == -1) {
+                            throw std::system_error(network_errno, std::system_category(), "We were unable to get the port from the UDP socket");
                         }
+                        Receiver once(ntohs(address.sin_port));
+
+                        // Nothing can be held for next time so only take what we can hand out now
+                        once.receive(event.fd, 1);
+                        return once.empty() ? p : once.pop();
                     }
 
-                    // Get the port this socket is listening on
-                    socklen_t len = sizeof(sockaddr_in);
-                    sockaddr_in address;
-                    if (::getsockname(event.fd, reinterpret_cast<sockaddr*>(&address), &len) == -1) {
-                        throw std::system_error(network_errno, std::system_category(), "We were unable to get the port from the UDP socket");
+                    std::lock_guard<std::mutex> lock(receiver->mutex);
+
+                    // Once we have handed out everything we read, read the socket again
+                    if (receiver->empty()) {
+                        receiver->receive(event.fd, limit);
+                        if (receiver->empty()) {
+                            return p;
+                        }
                     }
 
-                    // if no error
-                    if(received > 0) {
-                        p.valid = true;
-                        p.remote.address = ntohl(from.sin_addr.s_addr);
-                        p.remote.port = ntohs(from.sin_port);
-                        p.local.address = ntohl(ourAddr);
-                        p.local.port = ntohs(address.sin_port);
-                        p.data.resize(size_t(received));
+                    p = receiver->pop();
+
+                    // Let the controller know it should ask us again for the rest
+                    if (IO::ThreadDrainStore::value) {
+                        *IO::ThreadDrainStore::value = !receiver->empty();
                     }
 
                     return p;
@@ -269,9 +549,13 @@ namespace NUClear {
                         }
                         port = ntohs(address.sin_port);
 
+                        // Remember our port so we don't have to look it up for every packet
+                        sockets().add(fd, port);
+
                         // Generate a reaction for the IO system that closes on death
                         int cfd = fd;
                         auto reaction = util::generate_reaction<DSL, IO>(reactor, label, std::forward<TFunc>(callback), [cfd] (threading::Reaction&) {
+                            sockets().remove(cfd);
                             close(cfd);
                         });
 
@@ -281,6 +565,9 @@ namespace NUClear {
                             std::move(reaction)
                         });
 
+                        // Each event gets a packet for everything that was waiting on the socket
+                        ioConfig->drain = true;
+
                         threading::ReactionHandle handle(ioConfig->reaction);
 
                         // Send our configuration out
@@ -337,6 +624,9 @@ namespace NUClear {
                         }
                         port = ntohs(address.sin_port);
 
+                        // Remember our port so we don't have to look it up for every packet
+                        sockets().add(fd, port);
+
                         // Get all the network interfaces that support multicast
                         std::vector<uint32_t> addresses;
                         for(auto& iface : util::network::get_interfaces()) {
@@ -364,18 +654,24 @@ namespace NUClear {
                         int cfd = fd;
                         auto reaction = util::generate_reaction<DSL, IO>(reactor, label, std::forward<TFunc>(callback), [cfd] (threading::Reaction&) {
                             // Close all the sockets
+                            sockets().remove(cfd);
                             close(cfd);
                         });
 
                         std::shared_ptr<threading::Reaction> r(std::move(reaction));
                         threading::ReactionHandle handle(r);
 
-                        // Send our configuration out for each file descriptor (same reaction)
-                        reactor.powerplant.emit<emit::Direct>(std::make_unique<IOConfiguration>(IOConfiguration {
+                        auto ioConfig = std::make_unique<IOConfiguration>(IOConfiguration {
                             fd.release(),
                             IO::READ,
                             r
-                        }));
+                        });
+
+                        // Each event gets a packet for everything that was waiting on the socket
+                        ioConfig->drain = true;
+
+                        // Send our configuration out for each file descriptor (same reaction)
+                        reactor.powerplant.emit<emit::Direct>(ioConfig);
 
                         // Return our handles
                         return std::make_tuple(handle, port, cfd);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_WORD_WITHNEAREST_HPP
+#define NUCLEAR_DSL_WORD_WITHNEAREST_HPP
+
+#include "nuclear_bits/dsl/operation/CacheGet.hpp"
+#include "nuclear_bits/dsl/store/TimeStore.hpp"
+#include "nuclear_bits/dsl/trait/timestamp.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace word {
+
+            /**
+             * @ingroup Wrappers
+             * @brief This is a wrapper class which is used to get the data closest in time to another piece of data.
+             *
+             * @details
+             *  This class is used in the on binding to get the message of type TData whose timestamp is closest to the
+             *  timestamp of the TReference message that the callback is running with. For example
+             *  @code on<Trigger<Image>, WithNearest<IMU, Image>>() @endcode
+             *  would run with the IMU message that was closest in time to the image. If no reference type is given then
+             *  the message closest to the current time is used. Both types must provide a trait::timestamp, and like
+             *  With the callback will not run if there is no data available.
+             *
+             * @tparam TData        the datatype to search the time history of
+             * @tparam TReference   the datatype whose timestamp is searched for
+             */
+            template <typename TData, typename TReference = void>
+            struct WithNearest {
+
+                static_assert(trait::timestamp<TData>::value, "WithNearest can only be used on types with a timestamp trait");
+                static_assert(trait::timestamp<TReference>::value, "WithNearest must have a reference type with a timestamp trait");
+
+                template <typename DSL>
+                static inline std::shared_ptr<const TData> get(threading::Reaction& r) {
+
+                    // Find the time of our reference data
+                    auto reference = operation::CacheGet<TReference>::template get<DSL>(r);
+
+                    if(reference) {
+                        return store::TimeStore<TData>::nearest(trait::timestamp<TReference>::get(*reference));
+                    }
+                    else {
+                        return nullptr;
+                    }
+                }
+            };
+
+            template <typename TData>
+            struct WithNearest<TData, void> {
+
+                static_assert(trait::timestamp<TData>::value, "WithNearest can only be used on types with a timestamp trait");
+
+                template <typename DSL>
+                static inline std::shared_ptr<const TData> get(threading::Reaction&) {
+                    return store::TimeStore<TData>::nearest(clock::now());
+                }
+            };
+
+        }  // namespace word
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_WORD_WITHNEAREST_HPP
@@ -20,6 +20,7 @@
 
 #include "nuclear_bits/PowerPlant.hpp"
 #include "nuclear_bits/dsl/store/DataStore.hpp"
+#include "nuclear_bits/dsl/store/TimeStore.hpp"
 #include "nuclear_bits/dsl/store/TypeCallbackStore.hpp"
 
 namespace NUClear {
@@ -34,6 +35,7 @@ namespace NUClear {
 
                         // Set our data in the store
                         store::DataStore<TData>::set(data);
+                        store::record_time(data);
 
                         for(auto& reaction : store::TypeCallbackStore<TData>::get()) {
                             try {
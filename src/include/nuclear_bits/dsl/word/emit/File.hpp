@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_DSL_WORD_EMIT_FILE_HPP
+#define NUCLEAR_DSL_WORD_EMIT_FILE_HPP
+
+#include "nuclear_bits/util/serialise/Serialise.hpp"
+
+namespace NUClear {
+    namespace dsl {
+        namespace word {
+            namespace emit {
+
+                struct FileEmit {
+                    FileEmit() : path(""), data(), sync(false) {}
+
+                    std::string path;
+                    std::vector<char> data;
+                    bool sync;
+                };
+
+                /**
+                 * @brief
+                 *  When emitting data under this scope, the serialised data is appended to a file by the file
+                 *  controller's thread rather than the emitting thread.
+                 *
+                 * @details
+                 *  @code emit<Scope::FILE>(data, path, sync); @endcode
+                 *  The writes that are waiting for the file thread are made together, so many small writes to the
+                 *  same file only cost a few system calls. Once they are done a FileWritten message is emitted for
+                 *  each file with the number of bytes that were written and any error.
+                 *
+                 * @param data the data to write, which is serialised in the same way as for network emits
+                 * @param path the path of the file to append to, it is created if it doesn't exist
+                 * @param sync if the file should be synced to the disk before the FileWritten message is emitted
+                 *
+                 * @tparam TData the datatype that is being emitted
+                 */
+                template <typename TData>
+                struct File {
+
+                    static void emit(PowerPlant& powerplant, std::shared_ptr<TData> data, const std::string& path, bool sync = false) {
+
+                        auto e = std::make_unique<FileEmit>();
+
+                        e->path = path;
+                        e->data = util::serialise::Serialise<TData>::serialise(*data);
+                        e->sync = sync;
+
+                        powerplant.emit<Direct>(e);
+                    }
+                };
+
+            }  // namespace emit
+        }  // namespace word
+    }  // namespace dsl
+}  // namespace NUClear
+
+#endif  // NUCLEAR_DSL_WORD_EMIT_FILE_HPP
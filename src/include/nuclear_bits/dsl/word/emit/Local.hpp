@@ -22,6 +22,9 @@
 
 #include "nuclear_bits/dsl/store/TypeCallbackStore.hpp"
 #include "nuclear_bits/dsl/store/DataStore.hpp"
+#include "nuclear_bits/dsl/store/TimeStore.hpp"
+#include "nuclear_bits/dsl/store/ThreadStore.hpp"
+#include "nuclear_bits/dsl/word/Batch.hpp"
 
 namespace NUClear {
     namespace dsl {
@@ -35,6 +38,7 @@ namespace NUClear {
 
                         // Set our data in the store
                         store::DataStore<TData>::set(data);
+                        store::record_time(data);
 
                         for(auto& reaction : store::TypeCallbackStore<TData>::get()) {
                             try {
@@ -48,6 +52,62 @@ namespace NUClear {
                             }
                         }
                     }
+
+                    static void emit(PowerPlant& powerplant, std::vector<std::shared_ptr<TData>>& data) {
+
+                        // Nothing to do for an empty batch
+                        if(data.empty()) {
+                            return;
+                        }
+
+                        // Set our data in the store once using the most recent element
+                        store::DataStore<TData>::set(data.back());
+                        for(auto& element : data) {
+                            store::record_time(element);
+                        }
+
+                        auto& reactions = store::TypeCallbackStore<TData>::get();
+                        auto& batchReactions = store::TypeCallbackStore<Batch<TData>>::get();
+
+                        std::vector<std::unique_ptr<threading::ReactionTask>> tasks;
+                        tasks.reserve(data.size() * reactions.size() + batchReactions.size());
+
+                        // Make a task for each element by exposing it to the getters through our thread store
+                        for(auto& element : data) {
+                            store::ThreadStore<std::shared_ptr<TData>>::value = &element;
+
+                            for(auto& reaction : reactions) {
+                                try {
+                                    auto task = reaction->getTask();
+                                    if(task) {
+                                        tasks.push_back(std::move(task));
+                                    }
+                                }
+                                catch(...) {
+                                }
+                            }
+                        }
+                        store::ThreadStore<std::shared_ptr<TData>>::value = nullptr;
+
+                        // Reactions that want the whole batch get a single task for it
+                        if(!batchReactions.empty()) {
+                            store::DataStore<Batch<TData>>::set(std::make_shared<Batch<TData>>(data.begin(), data.end()));
+
+                            for(auto& reaction : batchReactions) {
+                                try {
+                                    auto task = reaction->getTask();
+                                    if(task) {
+                                        tasks.push_back(std::move(task));
+                                    }
+                                }
+                                catch(...) {
+                                }
+                            }
+                        }
+
+                        // Hand all of the tasks to the scheduler at once
+                        powerplant.submit(std::move(tasks));
+                    }
                 };
 
             }  // namespace emit
@@ -30,7 +30,7 @@
 #endif
 
 #include "nuclear_bits/PowerPlant.hpp"
-#include "nuclear_bits/util/FileDescriptor.hpp"
+#include "nuclear_bits/util/network/SenderSockets.hpp"
 #include "nuclear_bits/util/serialise/Serialise.hpp"
 #include "nuclear_bits/dsl/store/DataStore.hpp"
 #include "nuclear_bits/dsl/store/TypeCallbackStore.hpp"
@@ -45,57 +45,42 @@ namespace NUClear {
 
                     static inline void emit(PowerPlant&, std::shared_ptr<TData> input, in_addr_t toAddr, in_port_t toPort, in_addr_t fromAddr, in_port_t fromPort) {
 
-                        sockaddr_in src;
-                        sockaddr_in target;
-                        memset(&src, 0, sizeof(sockaddr_in));
-                        memset(&target, 0, sizeof(sockaddr_in));
+                        sockaddr_in target = address(toAddr, toPort);
 
-                        // Get socket addresses for our source and target
-                        src.sin_family = AF_INET;
-                        src.sin_addr.s_addr = htonl(fromAddr);
-                        src.sin_port = htons(fromPort);
+                        // Serialise the data
+                        std::vector<char> data = util::serialise::Serialise<TData>::serialise(*input);
 
-                        target.sin_family = AF_INET;
-                        target.sin_addr.s_addr = htonl(toAddr);
-                        target.sin_port = htons(toPort);
+                        // Try to send our data
+                        if(::sendto(sender(toAddr, fromAddr, fromPort), data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&target), sizeof(sockaddr_in)) < 0) {
+                            throw std::system_error(network_errno, std::system_category(), "We were unable to send the UDP message");
+                        }
+                    }
 
-                        // Work out if we are sending to a multicast address
-                        bool multicast = ((toAddr >> 28) == 14);
+                    // Batches of data are sent together
+                    static inline void emit(PowerPlant&, std::vector<std::shared_ptr<TData>>& batch, in_addr_t toAddr, in_port_t toPort, in_addr_t fromAddr, in_port_t fromPort) {
 
-                        // Open a socket to send the datagram from
-                        util::FileDescriptor fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-                        if(fd < 0) {
-                            throw std::system_error(network_errno, std::system_category(), "We were unable to open the UDP socket");
+                        // Serialise all the data
+                        std::vector<std::vector<char>> datagrams;
+                        datagrams.reserve(batch.size());
+                        for(auto& input : batch) {
+                            datagrams.push_back(util::serialise::Serialise<TData>::serialise(*input));
                         }
 
-                        // If we need to, bind to a port on our end
-                        if(fromAddr != 0 || fromPort != 0) {
-                            if(::bind(fd, reinterpret_cast<sockaddr*>(&src), sizeof(sockaddr))) {
-                                throw std::system_error(network_errno, std::system_category(), "We were unable to bind the UDP socket to the port");
-                            }
-                        }
+                        util::network::send_datagrams(sender(toAddr, fromAddr, fromPort), address(toAddr, toPort), datagrams);
+                    }
 
-                        // If we are using multicast and we have a specific fromAddr we need to tell the system to use it
-                        if(multicast && fromAddr != 0) {
-                            // Set our transmission interface for the multicast socket
-                            if(setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, reinterpret_cast<const char*>(&src.sin_addr), sizeof(src.sin_addr)) < 0) {
-                                throw std::system_error(network_errno, std::system_category(), "We were unable to use the requested interface for multicast");
-                            }
-                        }
+                    static inline void emit(PowerPlant& pp, std::vector<std::shared_ptr<TData>>& batch, in_addr_t toAddr, in_port_t toPort) {
+                        emit(pp, batch, toAddr, toPort, INADDR_ANY, in_port_t(0));
+                    }
 
-                        // This isn't the greatest code, but lets assume our users don't send broadcasts they don't mean to...
-                        int yes = true;
-                        if(setsockopt(fd, SOL_SOCKET, SO_BROADCAST, reinterpret_cast<const char*>(&yes), sizeof(yes)) < 0) {
-                            throw std::system_error(network_errno, std::system_category(), "We were unable to enable broadcasting on this socket");
-                        }
+                    static inline void emit(PowerPlant& pp, std::vector<std::shared_ptr<TData>>& batch, std::string toAddr, in_port_t toPort) {
 
-                        // Serialise the data
-                        std::vector<char> data = util::serialise::Serialise<TData>::serialise(*input);
+                        in_addr addr;
 
-                        // Try to send our data
-                        if(::sendto(fd, data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&target), sizeof(sockaddr_in)) < 0) {
-                            throw std::system_error(network_errno, std::system_category(), "We were unable to send the UDP message");
-                        }
+                        inet_pton(AF_INET, toAddr.c_str(), &addr);
+                        in_addr_t to = ntohl(addr.s_addr);
+
+                        emit(pp, batch, to, toPort, INADDR_ANY, in_port_t(0));
                     }
 
                     // String ip addresses
@@ -147,6 +132,26 @@ namespace NUClear {
 
                         emit(pp, data, to, toPort, INADDR_ANY, in_port_t(0));
                     }
+
+                private:
+                    static inline sockaddr_in address(in_addr_t addr, in_port_t port) {
+                        sockaddr_in out;
+                        memset(&out, 0, sizeof(sockaddr_in));
+                        out.sin_family = AF_INET;
+                        out.sin_addr.s_addr = htonl(addr);
+                        out.sin_port = htons(port);
+                        return out;
+                    }
+
+                    // Gets a socket that sends from this address and port, only those on any port are shared
+                    static inline util::network::SenderSockets::Sender sender(in_addr_t toAddr, in_addr_t fromAddr, in_port_t fromPort) {
+
+                        // If we are sending to a multicast address from a specific fromAddr we need to tell the system to use it
+                        bool multicast = ((toAddr >> 28) == 14);
+                        in_addr_t multicastInterface = multicast ? fromAddr : in_addr_t(INADDR_ANY);
+
+                        return util::network::SenderSockets::instance().get(fromAddr, fromPort, multicastInterface);
+                    }
                 };
 
             }  // namespace emit
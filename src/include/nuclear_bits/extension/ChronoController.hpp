@@ -18,35 +18,71 @@
 #ifndef NUCLEAR_EXTENSION_CHRONOCONTROLLER
 #define NUCLEAR_EXTENSION_CHRONOCONTROLLER
 
+#include <unordered_map>
+
 #include "nuclear"
+#include "nuclear_bits/util/TimingWheel.hpp"
 
 namespace NUClear {
     namespace extension {
 
         class ChronoController : public Reactor {
         private:
-            struct Step {
-                Step() : jump(), next(), reactions() {}
-                Step(const clock::duration& jump, const clock::time_point& next
-                    , const std::vector<std::shared_ptr<threading::Reaction>>& reactions)
+            /// @brief a timer for a single Every reaction, repeated every jump
+            struct Step : public util::TimingWheel::Timer {
+                Step(const clock::duration& jump, const std::shared_ptr<threading::Reaction>& reaction)
                 : jump(jump)
-                , next(next)
-                , reactions(reactions) {}
+                , reaction(reaction)
+                , jitter()
+                , overruns(0)
+                , skipped(0) {}
 
                 clock::duration jump;
-                clock::time_point next;
-                std::vector<std::shared_ptr<threading::Reaction>> reactions;
+                std::shared_ptr<threading::Reaction> reaction;
 
-                bool operator< (const Step& other) const {
-                    return next < other.next;
-                }
+                /// @brief how late each tick was submitted compared to when it was planned
+                util::LatencyHistogram jitter;
+                /// @brief the number of ticks that ran when the next tick was already due
+                uint64_t overruns;
+                /// @brief the number of ticks that were dropped by the overrun policy
+                uint64_t skipped;
             };
 
         public:
             explicit ChronoController(std::unique_ptr<NUClear::Environment> environment);
+            ~ChronoController();
 
         private:
-            std::vector<Step> steps;
+            /**
+             * @brief Submits the reactions of every step that is due and schedules their next run.
+             *
+             * @param now the current time
+             */
+            void expire(const clock::time_point& now);
+
+            /**
+             * @brief Gets the first time at or after the given time that is a multiple of the period since the epoch.
+             *
+             * @param time   the earliest time to return
+             * @param period the period to align to
+             */
+            static clock::time_point aligned(const clock::time_point& time, const clock::duration& period);
+
+            /**
+             * @brief Lets whatever is waiting for the next step know that the steps have changed.
+             */
+            void poke();
+
+            /// @brief the timerfd that the IO controller wakes us with, or -1 if we wait on our own thread
+            fd_t timerfd;
+            /// @brief the steps for each Every reaction, by reaction id
+            std::unordered_map<uint64_t, std::unique_ptr<Step>> steps;
+            /// @brief the timing wheel that holds our steps until they are next due
+            util::TimingWheel wheel;
+            /// @brief how we wait for steps and what we do when they overrun
+            message::ChronoConfiguration configuration;
+            /// @brief the time the current jitter snapshot interval started
+            clock::time_point snapshotStart;
             std::mutex mutex;
             std::condition_variable wait;
         };
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_EXTENSION_FILECONTROLLER_HPP
+#define NUCLEAR_EXTENSION_FILECONTROLLER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+
+#include "nuclear"
+
+namespace NUClear {
+    namespace extension {
+
+        /**
+         * @brief Makes the file writes from Scope::FILE emits and the reads for FileRead reactions on its own thread.
+         *
+         * @details
+         *  Requests are queued as they arrive and the thread takes all of the ones that are waiting at once. Writes
+         *  go through a large stdio buffer for each file, which is flushed once the whole queue has been handled, so
+         *  the writes to a file are coalesced into as few system calls as possible. A FileWritten message is then
+         *  emitted for each file that was written. Files are kept open between writes, up to MAX_OPEN_FILES of them.
+         *  When another file is needed the one that has gone unused the longest is closed, and every file is closed
+         *  once the writes that were queued at shutdown are done.
+         *
+         *  Once the system has shut down, requests are handled on the thread that made them.
+         */
+        class FileController : public Reactor {
+        private:
+            /// @brief a write or a read that is waiting for the file thread
+            struct Request {
+                Request() : path(""), data(), sync(false), reaction() {}
+
+                std::string path;
+                /// @brief the data to write, if this is a write
+                std::vector<char> data;
+                bool sync;
+                /// @brief the reaction to run with the contents of the file, if this is a read
+                std::shared_ptr<threading::Reaction> reaction;
+            };
+
+            /// @brief an open file and what has been written to it in the current batch
+            struct File {
+                File() : handle(nullptr), error(0), used(0), written() {}
+                ~File() {
+                    if(handle) {
+                        std::fclose(handle);
+                    }
+                }
+
+                File(const File&) = delete;
+                File& operator=(const File&) = delete;
+
+                std::FILE* handle;
+                /// @brief the error number from the last time we failed to open the file
+                int error;
+                /// @brief when this file was last used, larger numbers are more recent
+                uint64_t used;
+                /// @brief the writes to this file in the current batch, or nullptr if there weren't any
+                std::unique_ptr<message::FileWritten> written;
+            };
+
+        public:
+            explicit FileController(std::unique_ptr<NUClear::Environment> environment);
+
+            /// @brief the most files that are kept open between writes
+            static constexpr size_t MAX_OPEN_FILES = 32;
+
+        private:
+            /// @brief queues a request for the file thread, or handles it now if there isn't one anymore
+            void queue(Request&& request);
+
+            /// @brief writes, reads and reports on a batch of requests, fileMutex must be held
+            void process(std::vector<Request>& batch);
+
+            /// @brief gets the file for a path, opening it if it isn't already
+            File& open(const std::string& path);
+
+            /// @brief closes the files that have gone unused the longest until there is room to open another
+            void evict();
+
+            /// @brief flushes the writes to a file, syncs it if asked, and emits the FileWritten message
+            void finish(File& file);
+
+            /// @brief the size of the stdio buffer for each file
+            static constexpr size_t BUFFER_SIZE = 65536;
+
+            bool shutdown = false;
+
+            /// @brief protects requests and shutdown
+            std::mutex mutex;
+            std::condition_variable wait;
+            std::vector<Request> requests;
+
+            /// @brief held while a batch is being processed so only one thread uses the files
+            std::mutex fileMutex;
+            std::unordered_map<std::string, File> files;
+            /// @brief the number of times a file has been used, used to find the least recently used file
+            uint64_t uses;
+        };
+
+    }  // namespace extension
+}  // namespace NUClear
+
+#endif  // NUCLEAR_EXTENSION_FILECONTROLLER_HPP
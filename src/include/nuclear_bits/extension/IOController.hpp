@@ -18,8 +18,10 @@
 #ifndef NUCLEAR_EXTENSION_IOCONTROLLER
 #define NUCLEAR_EXTENSION_IOCONTROLLER
 
-#ifdef _WIN32
+#if defined(_WIN32)
     #include "IOController_Windows.hpp"
+#elif defined(__linux__) && !defined(NUCLEAR_POLL_IO)
+    #include "IOController_Linux.hpp"
 #else
     #include "IOController_Posix.hpp"
 #endif  // _WIN32
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NUCLEAR_EXTENSION_IOCONTROLLER_LINUX_HPP
+#define NUCLEAR_EXTENSION_IOCONTROLLER_LINUX_HPP
+
+#include "nuclear"
+#include "nuclear_bits/dsl/word/IO.hpp"
+#include "nuclear_bits/util/IOUring.hpp"
+
+#include <atomic>
+#include <unordered_map>
+#include <sys/epoll.h>
+
+namespace NUClear {
+    namespace extension {
+
+        /**
+         * @brief Waits for IO events using epoll or io_uring and submits the reactions that are interested in them.
+         *
+         * @details
+         *  With epoll each file descriptor is registered once, when its first reaction is configured, and is modified
+         *  or removed as reactions come and go. The epoll event holds a pointer to the file descriptor's watch, so
+         *  handling an event doesn't depend on how many file descriptors are being watched.
+         *
+         *  If PowerPlant::Configuration::ioUring is set and the kernel allows it, an io_uring is used instead. Each
+         *  watch then has a poll operation in the ring that is added again each time it completes. All of the changes
+         *  from a loop are submitted together with the wait for the next completions in a single system call, and
+         *  the completions are handled in bulk. As only the IO thread may use the ring, changes to the watches from
+         *  other threads are queued for it and it is woken to submit them.
+         *
+         *  Watches are one shot. Once a task has been submitted for an event, the controller stops watching for the
+         *  events of that reaction until its postcondition tells us the task has finished, unless the reaction was
+         *  configured to be watched while it runs. Until then the file descriptor is only watched for the events of
+         *  its other reactions, if it is watched at all.
+         *
+         *  Batch reactions are not given a task for each event. Their events are gathered while the events from a
+         *  wait are handled, and each gets a single task for all of them once we are done.
+         *
+         *  PowerPlant::Configuration::ioThreads sets how many IO threads there are. Each has a shard with its own
+         *  epoll or io_uring, and each file descriptor is watched by the shard its number hashes to. All of the file
+         *  descriptors of a batch reaction are watched by the shard of the first one.
+         */
+        class IOController : public Reactor {
+        private:
+
+            struct Task {
+                Task(int events, bool oneShot, bool batch, bool drain, const std::shared_ptr<threading::Reaction>& reaction)
+                    : events(events), oneShot(oneShot), batch(batch), drain(drain), running(false), reaction(reaction) {}
+
+                int events;
+                /// @brief if this reaction isn't watched while it is running
+                bool oneShot;
+                /// @brief if this reaction gets all of its events from a wait in one task
+                bool batch;
+                /// @brief if this reaction gets a task for everything its get read from an event
+                bool drain;
+                /// @brief if a task for this reaction has been submitted and hasn't finished yet
+                bool running;
+                std::shared_ptr<threading::Reaction> reaction;
+            };
+
+            /// @brief everything that is watching a single file descriptor
+            struct Watch {
+                Watch(const fd_t& fd) : fd(fd), registered(false), armed(0), queued(false), tasks() {}
+
+                fd_t fd;
+                /// @brief if this file descriptor has been added to epoll, or has a poll operation in the io_uring
+                bool registered;
+                /// @brief the events the poll operation in the io_uring is waiting for
+                uint32_t armed;
+                /// @brief if this watch is waiting for the IO thread to update its io_uring poll operation
+                bool queued;
+                std::vector<Task> tasks;
+            };
+
+            /// @brief a single IO thread and everything that it is watching
+            struct Shard {
+                Shard() : epoll(-1), ring(), notify(-1), mutex(), watches(), removed(), pending(), deferred(), events(256), fired(), batches() {}
+
+                /// @brief the epoll instance, or -1 if we are using io_uring
+                fd_t epoll;
+                /// @brief the io_uring, or nullptr if we are using epoll
+                std::unique_ptr<util::IOUring> ring;
+                /// @brief an eventfd that is used to wake up the IO thread
+                fd_t notify;
+
+                std::mutex mutex;
+                /// @brief the watch for each file descriptor
+                std::unordered_map<fd_t, std::unique_ptr<Watch>> watches;
+                /// @brief watches that are no longer used, but may still be referenced by events we have not handled
+                std::vector<std::unique_ptr<Watch>> removed;
+                /// @brief watches that the IO thread needs to update in the io_uring
+                std::vector<Watch*> pending;
+                /// @brief updates that didn't fit in the io_uring, retried after the next reap (nullptr is our eventfd)
+                std::vector<Watch*> deferred;
+                /// @brief the buffer that epoll fills with events
+                std::vector<epoll_event> events;
+                /// @brief the watches whose io_uring poll operations completed in this wait
+                std::vector<Watch*> fired;
+                /// @brief the events gathered for each batch reaction in this wait
+                std::vector<std::pair<std::shared_ptr<threading::Reaction>, IO::Events>> batches;
+            };
+
+            /// @brief where a reaction is being watched
+            struct Route {
+                Route() : shard(nullptr), fds() {}
+                Route(const Route&) = default;
+                Route(Route&&) = default;
+                Route& operator=(const Route&) = default;
+                Route& operator=(Route&&) = default;
+
+                /// @brief the shard that watches the reaction
+                Shard* shard;
+                /// @brief the file descriptors that the reaction is watching
+                std::vector<fd_t> fds;
+            };
+
+        public:
+            explicit IOController(std::unique_ptr<NUClear::Environment> environment);
+            ~IOController();
+
+        private:
+            /**
+             * @brief Registers, modifies or removes the watch so that we wait for the events of its tasks.
+             *
+             * @param shard the shard the watch belongs to
+             * @param watch the watch to update
+             */
+            void update(Shard& shard, Watch& watch);
+
+            /**
+             * @brief Submits the tasks of the watch that are interested in the events that happened.
+             *
+             * @details
+             *  The events for batch reactions are gathered in the shard instead, and are submitted by flush.
+             *
+             * @param shard  the shard the watch belongs to
+             * @param watch  the watch the events happened on
+             * @param events the events that happened
+             */
+            void dispatch(Shard& shard, Watch& watch, int events);
+
+            /// @brief submits a task for each batch reaction with the events that were gathered for it
+            void flush(Shard& shard);
+
+            /**
+             * @brief Sets if a reaction is running for every file descriptor it watches.
+             *
+             * @details
+             *  The watches are updated when the reaction stops running. While it is running, they will be updated
+             *  the next time they have an event.
+             *
+             * @param shard      the shard that watches the reaction, which must be locked
+             * @param fds        the file descriptors the reaction is watching
+             * @param reactionId the id of the reaction
+             * @param running    if the reaction is running
+             */
+            void setRunning(Shard& shard, const std::vector<fd_t>& fds, uint64_t reactionId, bool running);
+
+            /// @brief watches for the events of a reaction again now that its task has finished
+            void finished(uint64_t reactionId);
+
+            /// @brief waits for events with epoll and dispatches them
+            void waitEpoll(Shard& shard);
+
+            /// @brief submits the changes to our io_uring, waits for completions and dispatches them
+            void waitRing(Shard& shard);
+
+            /// @brief adds a poll operation to the io_uring for the eventfd, or for the watch if it is given
+            /// @details if the submission queue is full it is deferred until after the next reap
+            static void arm(Shard& shard, Watch* watch);
+
+            /// @brief queues a watch update that didn't fit in the io_uring to be tried again after the next reap
+            static void defer(Shard& shard, Watch* watch);
+
+            /// @brief frees a watch that has been removed once nothing in the io_uring refers to it
+            static void release(Shard& shard, Watch& watch);
+
+            /// @brief wakes up the IO thread of the shard
+            static void wake(Shard& shard);
+
+            /// @brief the shard that watches a file descriptor by default
+            Shard& shardFor(const fd_t& fd);
+
+            /// @brief the interest set of the tasks of a watch that aren't running
+            static uint32_t interest(const Watch& watch);
+
+            /// @brief set when we are shutting down so the IO threads stop waiting, read by every shard's thread
+            std::atomic<bool> shutdown;
+            /// @brief the shards that watch our file descriptors
+            std::vector<std::unique_ptr<Shard>> shards;
+            /// @brief protects routes
+            std::mutex routeMutex;
+            /// @brief where each reaction is watched, by reaction id
+            std::unordered_map<uint64_t, Route> routes;
+        };
+
+    }  // namespace extension
+}  // namespace NUClear
+
+#endif  // NUCLEAR_EXTENSION_IOCONTROLLER_LINUX_HPP
@@ -31,12 +31,20 @@ namespace NUClear {
         private:
 
             struct Task {
-                Task() : fd(), events(0), reaction() {}
-                Task(const fd_t& fd, short events, const std::shared_ptr<threading::Reaction>& reaction)
-                    : fd(fd), events(events), reaction(reaction) {}
+                Task() : fd(), events(0), oneShot(false), batch(false), drain(false), running(false), reaction() {}
+                Task(const fd_t& fd, short events, bool oneShot, bool batch, bool drain, const std::shared_ptr<threading::Reaction>& reaction)
+                    : fd(fd), events(events), oneShot(oneShot), batch(batch), drain(drain), running(false), reaction(reaction) {}
 
                 fd_t fd;
                 short events;
+                /// @brief if this reaction isn't watched while it is running
+                bool oneShot;
+                /// @brief if this reaction gets all of its events from a poll in one task
+                bool batch;
+                /// @brief if this reaction gets a task for everything its get read from an event
+                bool drain;
+                /// @brief if a task for this reaction has been submitted and hasn't finished yet
+                bool running;
                 std::shared_ptr<threading::Reaction> reaction;
 
                 bool operator< (const Task& other) const {
@@ -46,8 +54,19 @@ namespace NUClear {
 
         public:
             explicit IOController(std::unique_ptr<NUClear::Environment> environment);
+            ~IOController();
 
         private:
+            /**
+             * @brief Sets if a reaction is running for every file descriptor it watches. The lock must be held.
+             *
+             * @return true if the reaction is watched and isn't watched while it runs
+             */
+            bool setRunning(uint64_t reactionId, bool running);
+
+            /// @brief watches for the events of a reaction again now that its task has finished
+            void finished(uint64_t reactionId);
+
             fd_t notifyRecv;
             fd_t notifySend;
 
@@ -37,6 +37,7 @@ namespace NUClear {
                 SOCKET fd;
                 std::shared_ptr<threading::Reaction> reaction;
                 int events;
+                bool drain;
             };
 
             WSAEVENT notifier;
@@ -48,7 +48,7 @@ namespace NUClear {
                 in_port_t udpPort;
                 fd_t tcpFD;
                 ReactionHandle handle;
-                std::map<in_port_t, std::pair<clock::time_point, std::vector<std::vector<char>>>> buffer;
+                std::map<in_port_t, std::pair<clock::time_point, std::vector<util::BufferPool::Buffer>>> buffer;
                 std::mutex bufferMutex;
             };
 
@@ -68,6 +68,11 @@ namespace NUClear {
             static constexpr const size_t MAX_UDP_PAYLOAD_LENGTH = 1500 /*MTU*/ - 20 /*IP header*/ - 8 /*UDP header*/ - sizeof(network::DataPacket) + 1 /*Last char*/;
             static constexpr const size_t MAX_NUM_UDP_ASSEMBLEY = 5;
 
+            // Each of our packets is a header then a payload, when the kernel splits a large send (GSO) for us every
+            // packet must be this size except the last, and all of them together must fit in a single UDP packet
+            static constexpr const size_t UDP_SEGMENT_LENGTH = sizeof(network::DataPacket) - 1 + MAX_UDP_PAYLOAD_LENGTH;
+            static constexpr const size_t MAX_UDP_SEGMENTS = 65507 / UDP_SEGMENT_LENGTH;
+
             std::mutex writeMutex;
 
             ReactionHandle udpHandle;
@@ -85,6 +90,9 @@ namespace NUClear {
             int udpServerFD;
             int tcpServerFD;
 
+            // If the kernel can split our large UDP sends into packets for us
+            bool udpGSO;
+
             std::atomic<uint16_t> packetIDSource;
 
             std::mutex reactionMutex;
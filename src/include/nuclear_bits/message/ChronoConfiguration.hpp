@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_MESSAGE_CHRONOCONFIGURATION_HPP
+#define NUCLEAR_MESSAGE_CHRONOCONFIGURATION_HPP
+
+#include "nuclear_bits/clock.hpp"
+
+namespace NUClear {
+    namespace message {
+
+        /**
+         * @brief Configures how the ChronoController waits for the next Every reaction to be due.
+         *
+         * @details
+         *  The controller sleeps until spinWindow before the next reaction is due, and then busy waits for the rest
+         *  of the time to get an accurate start. A larger window gives more accurate timing when the system wakes up
+         *  late, at the cost of a core spinning for that long every tick. Use ChronoWakeup to tune it.
+         *
+         *  It also sets what happens when an Every reaction falls a whole period or more behind its schedule (for
+         *  example when the system stalls), and if periods are aligned to multiples of their length since the clock's
+         *  epoch. With the system clock this means an Every<1, std::chrono::seconds> will run on the second.
+         */
+        struct ChronoConfiguration {
+
+            /// @brief What to do when an Every reaction has fallen a whole period or more behind
+            enum Overrun {
+                /// @brief Run every missed tick as soon as possible, a stall turns into a burst of runs
+                CATCH_UP,
+                /// @brief Drop the missed ticks and carry on at the next tick in the original schedule
+                SKIP,
+                /// @brief Drop the missed ticks and start a new schedule one period from now
+                REALIGN
+            };
+
+            ChronoConfiguration() : spinWindow(std::chrono::microseconds(200)), overrun(CATCH_UP), align(false) {}
+            ChronoConfiguration(const clock::duration& spinWindow, Overrun overrun = CATCH_UP, bool align = false)
+            : spinWindow(spinWindow), overrun(overrun), align(align) {}
+
+            /// @brief How long before the next reaction is due the controller stops sleeping and busy waits
+            clock::duration spinWindow;
+            /// @brief What to do when an Every reaction falls a whole period or more behind
+            Overrun overrun;
+            /// @brief If every period should start on a multiple of its length since the clock's epoch
+            bool align;
+        };
+
+        /**
+         * @brief Emitted by the ChronoController each time it wakes up to run Every reactions.
+         *
+         * @details
+         *  This is only emitted if there is a reaction triggering on it.
+         */
+        struct ChronoWakeup {
+            ChronoWakeup() : target(), wake(), sleepError(0), lateness(0) {}
+
+            /// @brief The time the next Every reaction was due
+            clock::time_point target;
+            /// @brief The time the controller asked to wake up at (target minus the spin window)
+            clock::time_point wake;
+            /// @brief How long after the wake time the controller actually woke up, if larger than the spin window
+            ///        the reactions will run late
+            clock::duration sleepError;
+            /// @brief How long after the target time the reactions were actually submitted
+            clock::duration lateness;
+        };
+
+    }  // namespace message
+}  // namespace NUClear
+
+#endif  // NUCLEAR_MESSAGE_CHRONOCONFIGURATION_HPP
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NUCLEAR_MESSAGE_EVERYJITTERSNAPSHOT_HPP
+#define NUCLEAR_MESSAGE_EVERYJITTERSNAPSHOT_HPP
+
+#include <vector>
+
+#include "nuclear_bits/clock.hpp"
+#include "nuclear_bits/util/LatencyHistogram.hpp"
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
+
+namespace NUClear {
+    namespace message {
+
+        /**
+         * @brief Holds how late each Every reaction was started compared to its schedule over an interval.
+         *
+         * @details
+         *  This is emitted by the ChronoController with the same period as ReactionHistogramSnapshot, and only if
+         *  there is a reaction triggering on it. Each snapshot holds only the ticks since the previous snapshot.
+         */
+        struct EveryJitterSnapshot {
+
+            /**
+             * @brief The jitter of a single Every reaction.
+             */
+            struct Every {
+                Every() : identifier(), reactionId(0), period(0), jitter(), overruns(0), skipped(0) {}
+
+                /// @brief The label/reactor name/on arguments/and callback name of the reaction.
+                util::ReactionIdentifier identifier;
+                /// @brief The id of this reaction.
+                std::uint64_t reactionId;
+                /// @brief How often this reaction is meant to run
+                clock::duration period;
+                /// @brief The time between when each tick was planned and when its task was actually submitted
+                util::LatencyHistogram::Data jitter;
+                /// @brief The number of ticks that ran when the next tick was already due
+                std::uint64_t overruns;
+                /// @brief The number of ticks that were dropped because of the overrun policy
+                std::uint64_t skipped;
+            };
+
+            EveryJitterSnapshot() : start(), end(), every() {}
+
+            /// @brief The time that this interval started
+            clock::time_point start;
+            /// @brief The time that this interval ended
+            clock::time_point end;
+            /// @brief The jitter for every Every reaction
+            std::vector<Every> every;
+        };
+
+    }  // namespace message
+}  // namespace NUClear
+
+#endif  // NUCLEAR_MESSAGE_EVERYJITTERSNAPSHOT_HPP
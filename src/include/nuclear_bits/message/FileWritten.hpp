@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_MESSAGE_FILEWRITTEN_HPP
+#define NUCLEAR_MESSAGE_FILEWRITTEN_HPP
+
+#include <string>
+
+namespace NUClear {
+    namespace message {
+
+        /**
+         * @brief Emitted by the file controller once the writes that were emitted with Scope::FILE have been made.
+         *
+         * @details
+         *  Writes to the same file that were waiting together are reported in a single message.
+         */
+        struct FileWritten {
+            FileWritten() : path(""), bytes(0), writes(0), synced(false), error(0) {}
+
+            /// @brief the path of the file that was written to
+            std::string path;
+            /// @brief the number of bytes that were written
+            size_t bytes;
+            /// @brief the number of emits that were written
+            size_t writes;
+            /// @brief if the file was synced to the disk
+            bool synced;
+            /// @brief the error number of the first error, or 0 if everything was written
+            int error;
+        };
+
+    }  // namespace message
+}  // namespace NUClear
+
+#endif  // NUCLEAR_MESSAGE_FILEWRITTEN_HPP
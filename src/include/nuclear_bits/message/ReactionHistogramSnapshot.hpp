@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_MESSAGE_REACTIONHISTOGRAMSNAPSHOT_HPP
+#define NUCLEAR_MESSAGE_REACTIONHISTOGRAMSNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+
+#include "nuclear_bits/clock.hpp"
+#include "nuclear_bits/util/LatencyHistogram.hpp"
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
+
+namespace NUClear {
+    namespace message {
+
+        /**
+         * @brief Holds the latency histograms of every reaction over an interval.
+         *
+         * @details
+         *  This is emitted periodically by the PowerPlant (see PowerPlant::Configuration::histogramPeriod). Each
+         *  snapshot holds only the tasks that finished since the previous snapshot.
+         */
+        struct ReactionHistogramSnapshot {
+
+            /**
+             * @brief The histograms of a single reaction.
+             */
+            struct Reaction {
+                Reaction() : identifier(), reactionId(0), queue(), run(), throttled(0) {}
+
+                /// @brief The label/reactor name/on arguments/and callback name of the reaction.
+                util::ReactionIdentifier identifier;
+                /// @brief The id of this reaction.
+                std::uint64_t reactionId;
+                /// @brief The time tasks spent between being emitted and starting to run
+                util::LatencyHistogram::Data queue;
+                /// @brief The time tasks spent running
+                util::LatencyHistogram::Data run;
+                /// @brief The number of triggers Throttle has ignored in this interval
+                std::uint64_t throttled;
+            };
+
+            ReactionHistogramSnapshot() : start(), end(), reactions() {}
+
+            /// @brief The time that this interval started
+            clock::time_point start;
+            /// @brief The time that this interval ended
+            clock::time_point end;
+            /// @brief The histograms for every reaction that ran a task or was throttled in this interval
+            std::vector<Reaction> reactions;
+        };
+
+    }  // namespace message
+}  // namespace NUClear
+
+#endif  // NUCLEAR_MESSAGE_REACTIONHISTOGRAMSNAPSHOT_HPP
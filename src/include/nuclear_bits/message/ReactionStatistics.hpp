@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "nuclear_bits/clock.hpp"
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
 
 namespace NUClear {
     namespace message {
@@ -34,7 +35,7 @@ namespace NUClear {
         struct ReactionStatistics {
             ReactionStatistics() : identifier(), reactionId(0), taskId(0), causeReactionId(0), causeTaskId(0),
                                    emitted(), started(), finished(), exception() {}
-            ReactionStatistics(const std::vector<std::string> ident, std::uint64_t rId, std::uint64_t tId,
+            ReactionStatistics(const util::ReactionIdentifier& ident, std::uint64_t rId, std::uint64_t tId,
                                std::uint64_t causerId, std::uint64_t causetId, const clock::time_point& emitted,
                                const clock::time_point& start, const clock::time_point& finish,
                                const std::exception_ptr& exception)
@@ -48,8 +49,8 @@ namespace NUClear {
             , finished(finish)
             , exception(exception) {}
 
-            /// @brief A string containing the username/on arguments/and callback name of the reaction.
-            std::vector<std::string> identifier;
+            /// @brief The label/reactor name/on arguments/and callback name of the reaction, shared with the reaction.
+            util::ReactionIdentifier identifier;
             /// @brief The id of this reaction.
             std::uint64_t reactionId;
             /// @brief The task id of this reaction.
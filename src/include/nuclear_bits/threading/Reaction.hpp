@@ -21,9 +21,14 @@
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 
 #include "ReactionTask.hpp"
+#include "nuclear_bits/message/ReactionHistogramSnapshot.hpp"
+#include "nuclear_bits/util/LatencyHistogram.hpp"
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
 
 namespace NUClear {
 
@@ -57,10 +62,25 @@ namespace NUClear {
              * @param unbinder       the function used to unbind this reaction and clean it up
              */
             Reaction(Reactor& reactor
-                     , std::vector<std::string> identifier
-                     , std::function<std::pair<int, std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)>> (Reaction&)> callback
+                     , util::ReactionIdentifier identifier
+                     , std::function<std::pair<int, ReactionTask::TaskFunction> (Reaction&)> callback
                      , std::function<void (Reaction&)>&& unbinder);
 
+            ~Reaction();
+
+            Reaction(const Reaction&) = delete;
+            Reaction& operator=(const Reaction&) = delete;
+
+            /**
+             * @brief Adds the latency histograms of every existing reaction to the snapshot and resets them.
+             *
+             * @details
+             *  Reactions that have not finished any tasks since the last snapshot are not added.
+             *
+             * @param snapshot the snapshot to add the reaction histograms to
+             */
+            static void snapshotHistograms(message::ReactionHistogramSnapshot& snapshot);
+
             /**
              * @brief creates a new databound callback task that can be executed.
              *
@@ -76,8 +96,8 @@ namespace NUClear {
             /// @brief the reactor this belongs to
             Reactor& reactor;
 
-            /// @brief This holds the demangled name of the On function that is being called
-            std::vector<std::string> identifier;
+            /// @brief This holds the label, reactor and demangled names of the On function that is being called
+            const util::ReactionIdentifier identifier;
 
             /// @brief the unique identifier for this Reaction object
             const uint64_t reactionId;
@@ -88,6 +108,27 @@ namespace NUClear {
             /// @brief if this reaction object is currently enabled
             std::atomic<bool> enabled;
 
+            /// @brief if statistics should be collected for the tasks of this reaction
+            std::atomic<bool> statistics;
+
+            /// @brief the number of tasks that have been created by this reaction, used to sample statistics
+            std::atomic<uint64_t> taskCount;
+
+            /// @brief the time (as a count of clock ticks) that the Throttle token bucket for this reaction will be full
+            std::atomic<clock::rep> throttleTime;
+
+            /// @brief the number of triggers that Throttle has ignored for this reaction
+            std::atomic<uint64_t> throttled;
+
+            /// @brief the number of triggers that Throttle has ignored since the last histogram snapshot
+            std::atomic<uint64_t> throttledInterval;
+
+            /// @brief the time this reaction's tasks spent waiting between being emitted and starting to run
+            util::LatencyHistogram queueLatency;
+
+            /// @brief the time this reaction's tasks spent running
+            util::LatencyHistogram runLatency;
+
         private:
             /**
              * @brief Unbinds this reaction from it's context
@@ -96,8 +137,22 @@ namespace NUClear {
 
             /// @brief a source for reactionIds, atomically creates longs
             static std::atomic<uint64_t> reactionIdSource;
+            /// @brief every reaction that currently exists so their histograms can be collected
+            struct Registry {
+                Registry() : mutex(), reactions() {}
+                std::mutex mutex;
+                std::set<Reaction*> reactions;
+            };
+
+            /**
+             * @brief Gets the registry of existing reactions.
+             *
+             * @details
+             *  Reactions can be held by static stores, so the registry is never destroyed to ensure it outlives them.
+             */
+            static Registry& registry();
             /// @brief the callback generator function (creates databound callbacks)
-            std::function<std::pair<int, std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)>> (Reaction&)> generator;
+            std::function<std::pair<int, ReactionTask::TaskFunction> (Reaction&)> generator;
             /// @brief unbinds the reaction and cleans up
             std::function<void (Reaction&)> unbinder;
         };
@@ -76,6 +76,20 @@ namespace NUClear {
              */
             bool enabled();
 
+            /**
+             * @brief Sets if reaction statistics are collected for the tasks of this reaction.
+             *
+             * @param set true to collect statistics for this reaction, false to skip them
+             */
+            ReactionHandle& enableStatistics(bool set = true);
+
+            /**
+             * @brief Gets the number of triggers this reaction has ignored because of its Throttle.
+             *
+             * @return the number of ignored triggers, or 0 if the reaction no longer exists
+             */
+            uint64_t throttled();
+
             /**
              * @brief Unbinds the reaction and cleans up so it will never run again
              */
@@ -25,6 +25,7 @@
 #include <memory>
 
 #include "nuclear_bits/util/platform.hpp"
+#include "nuclear_bits/util/InlineFunction.hpp"
 #include "nuclear_bits/message/ReactionStatistics.hpp"
 
 namespace NUClear {
@@ -49,6 +50,8 @@ namespace NUClear {
             /// @brief the current task that is being executed by this thread (or nullptr if none is)
             static ATTRIBUTE_TLS ReactionTask* currentTask;
         public:
+            /// @brief the type of the data bound callback, small callbacks are stored inline without allocating
+            using TaskFunction = util::InlineFunction<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)>;
 
             /**
              * @brief Gets the current executing task, or nullptr if there isn't one.
@@ -64,7 +67,7 @@ namespace NUClear {
              * @param priority  the priority to use when executing this task.
              * @param callback  the data bound callback to be executed in the threadpool.
              */
-            ReactionTask(Reaction& parent, int priority, std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)> callback);
+            ReactionTask(Reaction& parent, int priority, TaskFunction&& callback);
 
             /**
              * @brief Runs the internal data bound task and times it.
@@ -81,12 +84,15 @@ namespace NUClear {
             uint64_t taskId;
             /// @brief the priority to run this task at
             int priority;
+            /// @brief the time that this task was created
+            clock::time_point emitted;
             /// @brief the statistics object that persists after this for information and debugging
+            /// @attention this is nullptr when statistics are not being collected for this task
             std::unique_ptr<message::ReactionStatistics> stats;
 
             /// @brief the data bound callback to be executed
             /// @attention note this must be last in the list as the this pointer is passed to the callback generator
-            std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)> callback;
+            TaskFunction callback;
         };
 
         /**
@@ -102,7 +108,7 @@ namespace NUClear {
             // If we ever have a null pointer, we move it to the top of the queue as it is being removed
             return a == nullptr ? false
                  : b == nullptr ? true
-                 : a->priority == b->priority ? a->stats->emitted < b->stats->emitted
+                 : a->priority == b->priority ? a->taskId < b->taskId
                  : a->priority < b->priority;
             
         }
@@ -27,6 +27,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <memory>
+#include <functional>
 #include "Reaction.hpp"
 
 namespace NUClear {
@@ -92,6 +93,17 @@ namespace NUClear {
              */
             void submit(std::unique_ptr<ReactionTask>&& task);
 
+            /**
+             * @brief Submit a group of new tasks to be executed to the Scheduler.
+             *
+             * @details
+             *  This method submits all of the tasks to the scheduler while only aquiring the lock once. The tasks will
+             *  then be sorted into the queue as if they had been submitted individually.
+             *
+             * @param tasks the tasks to be executed
+             */
+            void submit(std::vector<std::unique_ptr<ReactionTask>>&& tasks);
+
             /**
              * @brief Get a task object to be executed by a thread.
              *
@@ -103,6 +115,26 @@ namespace NUClear {
              * @return the task which has been given to be executed
              */
             std::unique_ptr<ReactionTask> getTask();
+
+            /**
+             * @brief Checks if the queue is empty and the given number of threads are all waiting for a task.
+             *
+             * @param threads the number of threads that take tasks from this scheduler
+             *
+             * @return true if there is no work queued or running
+             */
+            bool idle(size_t threads);
+
+            /**
+             * @brief Sets a function that is called each time a thread finds the queue empty and starts waiting.
+             *
+             * @details
+             *  The function is called without the scheduler's lock held, so it may call idle to check if every
+             *  thread is now waiting. It must be set before any threads start taking tasks.
+             *
+             * @param func the function to call
+             */
+            void onWait(std::function<void ()>&& func);
         private:
             /// @brief if the scheduler is running or is shut down
             volatile bool running;
@@ -112,6 +144,10 @@ namespace NUClear {
             std::mutex mutex;
             /// @brief the condition object that threads wait on if they can't get a task
             std::condition_variable condition;
+            /// @brief the number of threads that are waiting for a task
+            size_t waiting;
+            /// @brief called each time a thread starts waiting for a task
+            std::function<void ()> waitCallback;
 
         };
 
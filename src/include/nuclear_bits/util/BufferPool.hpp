@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_BUFFERPOOL_HPP
+#define NUCLEAR_UTIL_BUFFERPOOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace NUClear {
+    namespace util {
+
+        /**
+         * @brief A pool of buffers that are shared by reference counting and reused once they are released.
+         *
+         * @details
+         *  Each block holds its reference count and its pool in front of its data, so handing a buffer out and getting
+         *  it back doesn't allocate once the pool has grown to the number of buffers that are in use at a time. Blocks
+         *  come in power of two sizes from MIN_BLOCK_SIZE up to the pool's block size, so a small buffer doesn't hold
+         *  on to a whole large block. The pool must outlive every buffer that it hands out.
+         */
+        class BufferPool {
+        private:
+            struct Block {
+                Block(BufferPool& pool, size_t size) : references(1), pool(pool), size(size) {}
+
+                std::atomic<int> references;
+                BufferPool& pool;
+                /// @brief the number of bytes of data in the block
+                const size_t size;
+
+                char* data() {
+                    return reinterpret_cast<char*>(this + 1);
+                }
+            };
+
+        public:
+            /**
+             * @brief A reference to a buffer from a pool, the buffer goes back to the pool when the last one is gone.
+             */
+            class Buffer {
+            public:
+                Buffer() : block(nullptr), offset(0), length(0) {}
+
+                Buffer(const Buffer& other) : block(other.block), offset(other.offset), length(other.length) {
+                    if(block) {
+                        block->references.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                Buffer(Buffer&& other) noexcept : block(other.block), offset(other.offset), length(other.length) {
+                    other.block = nullptr;
+                    other.offset = 0;
+                    other.length = 0;
+                }
+
+                Buffer& operator=(Buffer other) noexcept {
+                    std::swap(block, other.block);
+                    std::swap(offset, other.offset);
+                    std::swap(length, other.length);
+                    return *this;
+                }
+
+                ~Buffer() {
+                    if(block && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        block->pool.recycle(block);
+                    }
+                }
+
+                /// @brief the data in the buffer
+                char* data() {
+                    return block ? block->data() + offset : nullptr;
+                }
+                const char* data() const {
+                    return block ? block->data() + offset : nullptr;
+                }
+
+                /// @brief the number of bytes in the buffer that are used
+                size_t size() const {
+                    return length;
+                }
+
+                /// @brief if there are no bytes used in the buffer
+                bool empty() const {
+                    return length == 0;
+                }
+
+                char& operator[](size_t i) {
+                    return data()[i];
+                }
+                const char& operator[](size_t i) const {
+                    return data()[i];
+                }
+
+                /// @brief the number of bytes the buffer can hold
+                size_t capacity() const {
+                    return block ? block->size - offset : 0;
+                }
+
+                /// @brief if this is the only reference to the buffer, so it can be written to without anyone seeing
+                bool unique() const {
+                    return block && block->references.load(std::memory_order_acquire) == 1;
+                }
+
+                /**
+                 * @brief Gets a reference to part of this buffer, which holds the whole buffer out of the pool.
+                 *
+                 * @param from   the offset of the part in this buffer
+                 * @param size   the number of bytes in the part, limited to what is left of the buffer
+                 *
+                 * @return a buffer that starts from the given offset in this one
+                 */
+                Buffer slice(size_t from, size_t size) const {
+                    Buffer part(*this);
+                    part.offset += from < capacity() ? from : capacity();
+                    part.resize(size);
+                    return part;
+                }
+
+                /// @brief sets the number of bytes that are used, which can't be more than the capacity
+                void resize(size_t size) {
+                    length = size < capacity() ? size : capacity();
+                }
+
+                const char* begin() const {
+                    return data();
+                }
+
+                const char* end() const {
+                    return data() + length;
+                }
+
+                operator bool() const {
+                    return block != nullptr;
+                }
+
+            private:
+                friend class BufferPool;
+                explicit Buffer(Block* block) : block(block), offset(0), length(block->size) {}
+
+                Block* block;
+                size_t offset;
+                size_t length;
+            };
+
+            /// @brief the size of the smallest buffers the pool hands out
+            static constexpr size_t MIN_BLOCK_SIZE = 256;
+
+            explicit BufferPool(size_t blockSize);
+            ~BufferPool();
+
+            BufferPool(const BufferPool&) = delete;
+            BufferPool& operator=(const BufferPool&) = delete;
+
+            /**
+             * @brief Gets a buffer from the pool, allocating a new one if they are all in use.
+             *
+             * @return a buffer whose size is the whole block
+             */
+            Buffer acquire();
+
+            /**
+             * @brief Gets the smallest buffer from the pool that can hold the given number of bytes.
+             *
+             * @param size the number of bytes the buffer must be able to hold, it is limited to the block size
+             *
+             * @return a buffer whose size is its capacity, which is a power of two (or the block size)
+             */
+            Buffer acquire(size_t size);
+
+            /// @brief the number of buffers that have been allocated by this pool
+            size_t allocated() const;
+
+            /// @brief the size of the largest buffers in the pool
+            const size_t blockSize;
+
+        private:
+            /// @brief puts a block that is no longer referenced back in the pool
+            void recycle(Block* block);
+
+            /// @brief the index of the smallest size of block that holds the given number of bytes
+            size_t sizeClass(size_t size) const;
+
+            mutable std::mutex mutex;
+            /// @brief the blocks that are not being used for each size of block, smallest first
+            std::vector<std::vector<Block*>> available;
+            /// @brief the number of blocks that have been allocated
+            size_t count;
+        };
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // NUCLEAR_UTIL_BUFFERPOOL_HPP
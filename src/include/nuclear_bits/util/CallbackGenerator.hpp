@@ -46,7 +46,7 @@ namespace NUClear {
         struct CallbackGenerator {
 
             CallbackGenerator(TFunc&& callback)
-            : callback(std::forward<TFunc>(callback))
+            : callback(std::make_shared<std::decay_t<TFunc>>(std::forward<TFunc>(callback)))
             , transients(std::make_shared<typename TransientDataElements<DSL>::type>()) {};
 
             template <typename... TData, int... DIndex, int... TIndex>
@@ -56,12 +56,12 @@ namespace NUClear {
                 unpack(MergeTransients<std::remove_reference_t<decltype(std::get<DIndex>(data))>>::merge(std::get<TIndex>(*transients), std::get<DIndex>(data))...);
             }
 
-            std::pair<int, std::function<std::unique_ptr<threading::ReactionTask> (std::unique_ptr<threading::ReactionTask>&&)>> operator()(threading::Reaction& r) {
+            std::pair<int, threading::ReactionTask::TaskFunction> operator()(threading::Reaction& r) {
 
                 // Check if we should even run
                 if(!DSL::precondition(r)) {
                     // We cancel our execution by returning an empty function
-                    return std::make_pair(0, std::function<std::unique_ptr<threading::ReactionTask> (std::unique_ptr<threading::ReactionTask>&&)>());
+                    return std::make_pair(0, threading::ReactionTask::TaskFunction());
                 }
                 else {
 
@@ -74,12 +74,11 @@ namespace NUClear {
                     // Check if our data is good (all the data exists) otherwise terminate the call
                     if(!checkData(data)) {
                         // We cancel our execution by returning an empty function
-                        return std::make_pair(0, std::function<std::unique_ptr<threading::ReactionTask> (std::unique_ptr<threading::ReactionTask>&&)>());
+                        return std::make_pair(0, threading::ReactionTask::TaskFunction());
                     }
 
-                    // We have to make a copy of the callback because the "this" variable can go out of scope
-                    auto c = callback;
-                    return std::make_pair(DSL::priority(r), [c, data] (std::unique_ptr<threading::ReactionTask>&& task) {
+                    // Our tasks share our callback rather than copying it, and keep it alive if the reaction is unbound first
+                    return std::make_pair(DSL::priority(r), threading::ReactionTask::TaskFunction([c = callback, data = std::move(data)] (std::unique_ptr<threading::ReactionTask>&& task) {
 
                         // Check if we are going to reschedule
                         task = DSL::reschedule(std::move(task));
@@ -90,37 +89,51 @@ namespace NUClear {
                             // Update our thread's priority to the correct level
                             update_current_thread_priority(task->priority);
 
+                            // We only time the task if we are collecting statistics for it
+                            auto& stats = task->stats;
+
                             // Record our start time
-                            task->stats->started = clock::now();
+                            if(stats) {
+                                stats->started = clock::now();
+                            }
 
                             // We have to catch any exceptions
                             try {
                                 // We call with only the relevant arguments to the passed function
-                                util::apply_relevant(c, std::move(data));
+                                util::apply_relevant(*c, std::move(data));
                             }
                             catch(...) {
 
                                 // Catch our exception if it happens
-                                task->stats->exception = std::current_exception();
+                                if(stats) {
+                                    stats->exception = std::current_exception();
+                                }
                             }
 
                             // Our finish time
-                            task->stats->finished = clock::now();
+                            if(stats) {
+                                stats->finished = clock::now();
+                            }
+
+                            // Our task is done, it stops being active before our postconditions so they can start another
+                            --task->parent.activeTasks;
 
                             // Run our postconditions
                             DSL::postcondition(*task);
 
                             // Emit our reaction statistics
-                            PowerPlant::powerplant->emit<dsl::word::emit::Direct>(task->stats);
+                            if(stats) {
+                                PowerPlant::powerplant->emit<dsl::word::emit::Direct>(stats);
+                            }
                         }
 
                         // Return our task
                         return std::move(task);
-                    });
+                    }));
                 }
             }
 
-            TFunc callback;
+            std::shared_ptr<const std::decay_t<TFunc>> callback;
             std::shared_ptr<typename TransientDataElements<DSL>::type> transients;
         };
 
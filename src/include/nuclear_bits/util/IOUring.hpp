@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NUCLEAR_UTIL_IOURING_HPP
+#define NUCLEAR_UTIL_IOURING_HPP
+
+// io_uring only exists on linux
+#ifdef __linux__
+
+#include <cstddef>
+#include <linux/io_uring.h>
+
+namespace NUClear {
+    namespace util {
+
+        /**
+         * @brief A minimal io_uring instance made directly with the system calls.
+         *
+         * @details
+         *  Submission queue entries are filled with next and are all submitted together by the next call to enter,
+         *  which can also wait for completions. Completions are then read in bulk with reap. An instance must only be
+         *  used by one thread at a time.
+         */
+        class IOUring {
+        public:
+            /**
+             * @brief Makes a new io_uring.
+             *
+             * @param entries the number of entries in the submission queue
+             *
+             * @throws std::system_error if the kernel doesn't support io_uring or won't let us use it
+             */
+            explicit IOUring(unsigned entries);
+            ~IOUring();
+
+            IOUring(const IOUring&) = delete;
+            IOUring& operator=(const IOUring&) = delete;
+
+            /**
+             * @brief Gets a cleared submission queue entry to fill, submitting the queue first if it is full.
+             *
+             * @return the entry, or nullptr if the queue is full and the kernel won't take any more entries until the
+             *         completions that are ready have been reaped
+             */
+            io_uring_sqe* next();
+
+            /**
+             * @brief Submits all of the entries from next and optionally waits for completions.
+             *
+             * @param waitFor the number of completions to wait for
+             *
+             * @return false if we were interrupted before they were all submitted
+             */
+            bool enter(unsigned waitFor);
+
+            /**
+             * @brief Calls the function with every completion that is ready, and then frees them.
+             *
+             * @param func the function to call with each completion
+             *
+             * @return the number of completions
+             */
+            template <typename TFunc>
+            unsigned reap(TFunc&& func) {
+
+                unsigned head = *cqHead;
+                unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+                for (unsigned i = head; i != tail; ++i) {
+                    func(cqes[i & *cqMask]);
+                }
+
+                __atomic_store_n(cqHead, tail, __ATOMIC_RELEASE);
+
+                return tail - head;
+            }
+
+        private:
+            /// @brief unmaps the queues and closes the ring
+            void release();
+
+            /**
+             * @brief Publishes and submits our entries, optionally waiting for completions.
+             *
+             * @return 0 on success, or EINTR, EBUSY or EAGAIN if the kernel couldn't take them right now
+             */
+            int submit(unsigned waitFor);
+
+            /// @brief the file descriptor of the ring
+            int fd;
+
+            /// @brief the mapped submission queue ring, completion queue ring and submission queue entries
+            void* sqRing;
+            size_t sqRingSize;
+            void* cqRing;
+            size_t cqRingSize;
+            io_uring_sqe* sqes;
+            size_t sqesSize;
+
+            /// @brief pointers into the submission queue ring
+            unsigned* sqHead;
+            unsigned* sqTail;
+            unsigned* sqMask;
+            unsigned* sqArray;
+            unsigned sqEntries;
+
+            /// @brief pointers into the completion queue ring
+            unsigned* cqHead;
+            unsigned* cqTail;
+            unsigned* cqMask;
+            io_uring_cqe* cqes;
+
+            /// @brief our tail of the submission queue, including entries that we haven't published yet
+            unsigned tail;
+            /// @brief the number of entries that we have published but the kernel hasn't taken yet
+            unsigned unsubmitted;
+        };
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // __linux__
+
+#endif  // NUCLEAR_UTIL_IOURING_HPP
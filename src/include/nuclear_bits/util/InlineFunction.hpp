@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_INLINEFUNCTION_HPP
+#define NUCLEAR_UTIL_INLINEFUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace NUClear {
+    namespace util {
+
+        template <typename Signature, size_t Size = 64>
+        class InlineFunction;
+
+        /**
+         * @brief A move only function wrapper that stores small functions inside itself rather than on the heap.
+         *
+         * @details
+         *  This works like std::function, except that any function object that fits in Size bytes is stored inside
+         *  this object, so wrapping it does not need to allocate. Function objects that are too large are allocated on
+         *  the heap as std::function would. As it is move only it can also hold function objects that can't be copied.
+         *
+         * @tparam R     the return type of the function
+         * @tparam TArgs the argument types of the function
+         * @tparam Size  the number of bytes available to store the function object inline
+         */
+        template <typename R, typename... TArgs, size_t Size>
+        class InlineFunction<R (TArgs...), Size> {
+        private:
+            /// @brief the operations that can be performed on the stored function by the manager
+            enum class Operation { MOVE, DESTROY, INLINE };
+
+            template <typename TFunc>
+            using fits = std::integral_constant<bool, sizeof(TFunc) <= Size
+                                                   && alignof(TFunc) <= alignof(std::max_align_t)
+                                                   && std::is_nothrow_move_constructible<TFunc>::value>;
+
+            // Functions that fit are stored directly in our storage
+            template <typename TFunc>
+            static TFunc* get(void* storage, std::true_type) {
+                return reinterpret_cast<TFunc*>(storage);
+            }
+
+            template <typename TFunc>
+            static bool manage(Operation op, void* dst, void* src, std::true_type) {
+                switch(op) {
+                    case Operation::MOVE:
+                        new (dst) TFunc(std::move(*reinterpret_cast<TFunc*>(src)));
+                        reinterpret_cast<TFunc*>(src)->~TFunc();
+                        break;
+                    case Operation::DESTROY:
+                        reinterpret_cast<TFunc*>(dst)->~TFunc();
+                        break;
+                    case Operation::INLINE:
+                        return true;
+                }
+                return false;
+            }
+
+            // Functions that don't fit store a pointer to a heap allocation in our storage
+            template <typename TFunc>
+            static TFunc* get(void* storage, std::false_type) {
+                return *reinterpret_cast<TFunc**>(storage);
+            }
+
+            template <typename TFunc>
+            static bool manage(Operation op, void* dst, void* src, std::false_type) {
+                switch(op) {
+                    case Operation::MOVE:
+                        *reinterpret_cast<TFunc**>(dst) = *reinterpret_cast<TFunc**>(src);
+                        break;
+                    case Operation::DESTROY:
+                        delete *reinterpret_cast<TFunc**>(dst);
+                        break;
+                    case Operation::INLINE:
+                        break;
+                }
+                return false;
+            }
+
+            template <typename TFunc>
+            static R invoke(void* storage, TArgs&&... args) {
+                return (*get<TFunc>(storage, fits<TFunc>()))(std::forward<TArgs>(args)...);
+            }
+
+            template <typename TFunc>
+            static bool manage(Operation op, void* dst, void* src) {
+                return manage<TFunc>(op, dst, src, fits<TFunc>());
+            }
+
+            template <typename TFunc, typename TArg>
+            void store(TArg&& f, std::true_type) {
+                new (&storage) TFunc(std::forward<TArg>(f));
+            }
+
+            template <typename TFunc, typename TArg>
+            void store(TArg&& f, std::false_type) {
+                *reinterpret_cast<TFunc**>(&storage) = new TFunc(std::forward<TArg>(f));
+            }
+
+            /// @brief the storage that holds our function object (or a pointer to it)
+            typename std::aligned_storage<Size, alignof(std::max_align_t)>::type storage;
+            /// @brief calls the stored function object
+            R (*invoker)(void*, TArgs&&...);
+            /// @brief moves or destroys the stored function object, or reports if it is stored inline
+            bool (*manager)(Operation, void*, void*);
+
+        public:
+            InlineFunction() noexcept : storage(), invoker(nullptr), manager(nullptr) {}
+
+            template <typename TFunc, typename = std::enable_if_t<!std::is_same<std::decay_t<TFunc>, InlineFunction>::value>>
+            InlineFunction(TFunc&& f)
+            : storage()
+            , invoker(&invoke<std::decay_t<TFunc>>)
+            , manager(&manage<std::decay_t<TFunc>>) {
+                store<std::decay_t<TFunc>>(std::forward<TFunc>(f), fits<std::decay_t<TFunc>>());
+            }
+
+            InlineFunction(InlineFunction&& other) noexcept : storage(), invoker(other.invoker), manager(other.manager) {
+                if(manager) {
+                    manager(Operation::MOVE, &storage, &other.storage);
+                    other.invoker = nullptr;
+                    other.manager = nullptr;
+                }
+            }
+
+            InlineFunction& operator=(InlineFunction&& other) noexcept {
+                if(this != &other) {
+                    reset();
+                    invoker = other.invoker;
+                    manager = other.manager;
+                    if(manager) {
+                        manager(Operation::MOVE, &storage, &other.storage);
+                        other.invoker = nullptr;
+                        other.manager = nullptr;
+                    }
+                }
+                return *this;
+            }
+
+            InlineFunction(const InlineFunction&) = delete;
+            InlineFunction& operator=(const InlineFunction&) = delete;
+
+            ~InlineFunction() {
+                reset();
+            }
+
+            /**
+             * @brief Destroys the stored function object leaving this empty.
+             */
+            void reset() {
+                if(manager) {
+                    manager(Operation::DESTROY, &storage, nullptr);
+                    invoker = nullptr;
+                    manager = nullptr;
+                }
+            }
+
+            R operator()(TArgs... args) {
+                return invoker(&storage, std::forward<TArgs>(args)...);
+            }
+
+            /**
+             * @brief Checks if the stored function object is held inside this object rather than on the heap.
+             *
+             * @return true if a function object is stored and it did not need to be allocated
+             */
+            bool stored_inline() const {
+                return manager != nullptr && manager(Operation::INLINE, nullptr, nullptr);
+            }
+
+            explicit operator bool() const {
+                return invoker != nullptr;
+            }
+        };
+
+    }  // namespace util
+}  //  namespace NUClear
+
+#endif  // NUCLEAR_UTIL_INLINEFUNCTION_HPP
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_LATENCYHISTOGRAM_HPP
+#define NUCLEAR_UTIL_LATENCYHISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "nuclear_bits/clock.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace NUClear {
+    namespace util {
+
+        /**
+         * @brief A lock free log-linear histogram of durations.
+         *
+         * @details
+         *  Durations are recorded in nanoseconds. Values below 16ns each have their own bucket, above that every power
+         *  of two is split into 16 linear buckets, so any recorded value is known to within about 6% (in the style of
+         *  an HDR histogram). Values past about 18 minutes are all counted in the last bucket. Recording is a couple of
+         *  relaxed atomic increments so it is cheap enough to do for every task that runs.
+         */
+        class LatencyHistogram {
+        public:
+            /// @brief the number of bits of each value that are kept, giving 2^SUB_BUCKET_BITS buckets per power of two
+            static constexpr int SUB_BUCKET_BITS = 4;
+            /// @brief the number of linear buckets for each power of two
+            static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+            /// @brief the number of bits in the largest value that has its own bucket
+            static constexpr int VALUE_BITS = 40;
+            /// @brief the total number of buckets in the histogram
+            static constexpr size_t BUCKETS = SUB_BUCKETS + (VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+            /**
+             * @brief A copy of the counts in a histogram at a point in time that can be queried.
+             */
+            struct Data {
+                Data() : count(0), sum(0), max(0), buckets() {}
+
+                /// @brief the number of values that were recorded
+                uint64_t count;
+                /// @brief the sum of all the values that were recorded in nanoseconds
+                uint64_t sum;
+                /// @brief the largest value that was recorded in nanoseconds
+                uint64_t max;
+                /// @brief the number of values recorded in each bucket
+                std::vector<uint64_t> buckets;
+
+                /**
+                 * @brief Gets the value that the given percentage of recorded values are less than or equal to.
+                 *
+                 * @param percent the percentile to get, e.g. 99.9 for the p999
+                 *
+                 * @return the highest duration that falls in the same bucket as the percentile (zero if empty)
+                 */
+                clock::duration percentile(double percent) const {
+
+                    if (count == 0) {
+                        return clock::duration(0);
+                    }
+
+                    // Work out how many values we need to pass to reach this percentile
+                    uint64_t target = uint64_t(std::ceil(count * (percent / 100.0)));
+                    target = target < 1 ? 1 : target > count ? count : target;
+
+                    uint64_t seen = 0;
+                    for (size_t i = 0; i < buckets.size(); ++i) {
+                        seen += buckets[i];
+                        if (seen >= target) {
+                            uint64_t value = highest(i);
+                            return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(value < max ? value : max));
+                        }
+                    }
+
+                    return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(max));
+                }
+
+                /**
+                 * @brief Gets the mean of the recorded values.
+                 */
+                clock::duration mean() const {
+                    return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(count == 0 ? 0 : sum / count));
+                }
+            };
+
+            LatencyHistogram() : counts(), sum(0), max(0) {
+                for (auto& c : counts) {
+                    c.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Gets the bucket that a value in nanoseconds is counted in.
+             */
+            static size_t index(uint64_t value) {
+
+                if (value < SUB_BUCKETS) {
+                    return size_t(value);
+                }
+
+                // Find the most significant bit of the value
+                int msb = 63 - clz(value);
+
+                // Values too large for the histogram go in the last bucket
+                if (msb >= VALUE_BITS) {
+                    return BUCKETS - 1;
+                }
+
+                // Keep the top SUB_BUCKET_BITS bits after the most significant one to find the linear bucket
+                int shift = msb - SUB_BUCKET_BITS;
+                return size_t(SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS));
+            }
+
+            /**
+             * @brief Gets the highest value in nanoseconds that would be counted in a bucket.
+             */
+            static uint64_t highest(size_t index) {
+
+                if (index < SUB_BUCKETS) {
+                    return uint64_t(index);
+                }
+
+                uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+                uint64_t sub   = (index - SUB_BUCKETS) % SUB_BUCKETS;
+                return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+            }
+
+            /**
+             * @brief Records a duration in the histogram.
+             *
+             * @param duration the duration to record, negative durations are counted as zero
+             */
+            void record(const clock::duration& duration) {
+
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                uint64_t value = ns < 0 ? 0 : uint64_t(ns);
+
+                counts[index(value)].fetch_add(1, std::memory_order_relaxed);
+                sum.fetch_add(value, std::memory_order_relaxed);
+
+                // Update our maximum if this is larger
+                uint64_t current = max.load(std::memory_order_relaxed);
+                while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                }
+            }
+
+            /**
+             * @brief Copies out the current counts of the histogram.
+             *
+             * @details
+             *  If reset is true the counts are cleared as they are read so the next snapshot only holds values recorded
+             *  after this one. Values recorded while the snapshot is being taken will end up in one or the other.
+             *
+             * @param reset if the histogram should be cleared for the next interval
+             */
+            Data snapshot(bool reset) {
+
+                Data data;
+                data.buckets.resize(size_t(BUCKETS));
+
+                for (size_t i = 0; i < BUCKETS; ++i) {
+                    data.buckets[i] = reset ? counts[i].exchange(0, std::memory_order_relaxed)
+                                            : counts[i].load(std::memory_order_relaxed);
+                    data.count += data.buckets[i];
+                }
+
+                data.sum = reset ? sum.exchange(0, std::memory_order_relaxed) : sum.load(std::memory_order_relaxed);
+                data.max = reset ? max.exchange(0, std::memory_order_relaxed) : max.load(std::memory_order_relaxed);
+
+                return data;
+            }
+
+        private:
+            /// @brief counts the leading zeros of a non zero value
+            static int clz(uint64_t value) {
+#if defined(_MSC_VER)
+                unsigned long msb;
+                _BitScanReverse64(&msb, value);
+                return 63 - int(msb);
+#else
+                return __builtin_clzll(value);
+#endif
+            }
+
+            /// @brief the number of values recorded in each bucket
+            std::array<std::atomic<uint64_t>, BUCKETS> counts;
+            /// @brief the sum of the values recorded
+            std::atomic<uint64_t> sum;
+            /// @brief the largest value recorded
+            std::atomic<uint64_t> max;
+        };
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // NUCLEAR_UTIL_LATENCYHISTOGRAM_HPP
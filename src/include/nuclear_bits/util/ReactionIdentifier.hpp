@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_REACTIONIDENTIFIER_HPP
+#define NUCLEAR_UTIL_REACTIONIDENTIFIER_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace NUClear {
+    namespace util {
+
+        /**
+         * @brief The identifier of a reaction, made once per reaction and shared by everything that refers to it.
+         *
+         * @details
+         *  An identifier holds four strings, the label given to the reaction, the name of the reactor it is in, the
+         *  type of its DSL and the type of its callback. Copying an identifier only copies a shared pointer to these
+         *  strings, so they are never copied for each task. The type names are only demangled the first time the
+         *  strings are looked at, as most identifiers are never read.
+         */
+        class ReactionIdentifier {
+        public:
+            /**
+             * @brief Creates an empty identifier, holding no strings.
+             */
+            ReactionIdentifier();
+
+            /**
+             * @brief Creates an identifier for a reaction.
+             *
+             * @param label     the label the user gave to the reaction
+             * @param reactor   the name of the reactor the reaction belongs to
+             * @param dsl       the type of the DSL of the reaction, demangled when needed
+             * @param function  the type of the reactions callback, demangled when needed
+             */
+            ReactionIdentifier(const std::string& label, const std::string& reactor, const std::type_info& dsl, const std::type_info& function);
+
+            /**
+             * @brief Gets the strings of this identifier, demangling them if this is the first time.
+             *
+             * @return the label, reactor name, DSL and callback names in that order, or no strings if empty
+             */
+            const std::vector<std::string>& get() const;
+
+            operator const std::vector<std::string>&() const {
+                return get();
+            }
+
+            const std::string& operator[](size_t index) const {
+                return get()[index];
+            }
+
+            size_t size() const {
+                return get().size();
+            }
+
+            std::vector<std::string>::const_iterator begin() const {
+                return get().begin();
+            }
+
+            std::vector<std::string>::const_iterator end() const {
+                return get().end();
+            }
+
+        private:
+            /// @brief the shared immutable identifier information
+            struct Names {
+                Names(const std::string& label, const std::string& reactor, const char* dsl, const char* function)
+                : dsl(dsl)
+                , function(function)
+                , demangled()
+                , strings({label, reactor}) {}
+
+                Names(const Names&) = delete;
+                Names& operator=(const Names&) = delete;
+
+                /// @brief the mangled name of the DSL type
+                const char* dsl;
+                /// @brief the mangled name of the callback type
+                const char* function;
+                /// @brief makes sure we only demangle once
+                std::once_flag demangled;
+                /// @brief the identifier strings once demangled
+                std::vector<std::string> strings;
+            };
+
+            /// @brief the identifier information, shared by every copy of this identifier
+            std::shared_ptr<Names> names;
+        };
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // NUCLEAR_UTIL_REACTIONIDENTIFIER_HPP
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_TIMINGWHEEL_HPP
+#define NUCLEAR_UTIL_TIMINGWHEEL_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "nuclear_bits/clock.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace NUClear {
+    namespace util {
+
+        /**
+         * @brief A hierarchical timing wheel holding timers that expire at a given time.
+         *
+         * @details
+         *  Time is split into ticks, and the wheel has LEVELS levels of SLOTS slots each. Level 0 holds timers that
+         *  expire in the current rotation of SLOTS ticks, each level above holds timers SLOTS times further away. As
+         *  time moves forward the slots of the higher levels are cascaded down into the lower levels. Timers more than
+         *  SLOTS^LEVELS ticks away are kept in an overflow list until they come in range.
+         *
+         *  Timers are intrusive linked list nodes owned by the user, so inserting and cancelling a timer is O(1) and
+         *  doesn't allocate. The tick only decides which slot a timer is kept in, timers are expired and reported by
+         *  next() at their exact time. The wheel is not thread safe.
+         */
+        class TimingWheel {
+        public:
+            /// @brief the number of bits of the tick count used to index each level
+            static constexpr int SLOT_BITS = 6;
+            /// @brief the number of slots in each level
+            static constexpr int SLOTS = 1 << SLOT_BITS;
+            /// @brief the number of levels in the wheel
+            static constexpr int LEVELS = 4;
+
+            /**
+             * @brief A timer that can be held in the wheel, usually as a base class of the users timer type.
+             */
+            struct Timer {
+                Timer() : when(), next(nullptr), pprev(nullptr), level(0), slot(0) {}
+
+                // Timers are linked into the wheel by their address
+                Timer(const Timer&) = delete;
+                Timer& operator=(const Timer&) = delete;
+
+                /// @brief the time this timer expires, this must not be changed while the timer is in a wheel
+                clock::time_point when;
+
+            private:
+                friend class TimingWheel;
+
+                /// @brief the next timer in the same slot
+                Timer* next;
+                /// @brief the pointer that points to this timer, nullptr if this timer is not in a wheel
+                Timer** pprev;
+                /// @brief the level this timer is in (LEVELS for the overflow list)
+                int level;
+                /// @brief the slot this timer is in
+                int slot;
+            };
+
+            /**
+             * @brief Creates a new empty timing wheel.
+             *
+             * @param start the time that the first tick of the wheel starts at
+             * @param tick  the duration of each tick of the wheel
+             */
+            TimingWheel(const clock::time_point& start, const clock::duration& tick = std::chrono::milliseconds(1))
+            : epoch(start), tick(tick), current(0), count(0), occupied(), slots(), overflow(nullptr) {
+                occupied.fill(0);
+                for (auto& level : slots) {
+                    level.fill(nullptr);
+                }
+            }
+
+            TimingWheel(const TimingWheel&) = delete;
+            TimingWheel& operator=(const TimingWheel&) = delete;
+
+            /**
+             * @brief Adds a timer to the wheel to expire at its when time, the timer must not already be in a wheel.
+             */
+            void insert(Timer& timer) {
+
+                // Timers that are already late go in the current tick
+                uint64_t t = ticks(timer.when);
+                t = t < current ? current : t;
+
+                // Our level is the highest group of bits that differs from the current tick
+                uint64_t diff = t ^ current;
+                int level = 0;
+                while (level < LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0) {
+                    ++level;
+                }
+
+                if (level == LEVELS) {
+                    link(timer, overflow, LEVELS, 0);
+                }
+                else {
+                    int slot = int((t >> (SLOT_BITS * level)) & (SLOTS - 1));
+                    link(timer, slots[level][slot], level, slot);
+                    occupied[level] |= uint64_t(1) << slot;
+                }
+                ++count;
+            }
+
+            /**
+             * @brief Removes a timer from the wheel, does nothing if the timer isn't in a wheel.
+             */
+            void cancel(Timer& timer) {
+
+                if (timer.pprev == nullptr) {
+                    return;
+                }
+
+                unlink(timer);
+                if (timer.level < LEVELS && slots[timer.level][timer.slot] == nullptr) {
+                    occupied[timer.level] &= ~(uint64_t(1) << timer.slot);
+                }
+                --count;
+            }
+
+            /**
+             * @brief Returns if the timer is currently in a wheel.
+             */
+            static bool linked(const Timer& timer) {
+                return timer.pprev != nullptr;
+            }
+
+            /**
+             * @brief Returns true if there are no timers in the wheel.
+             */
+            bool empty() const {
+                return count == 0;
+            }
+
+            /**
+             * @brief Returns the number of timers in the wheel.
+             */
+            size_t size() const {
+                return count;
+            }
+
+            /**
+             * @brief Gets the time that the next timer will expire, or clock::time_point::max() if there are none.
+             */
+            clock::time_point next() const {
+
+                if (count == 0) {
+                    return clock::time_point::max();
+                }
+
+                // The first occupied slot at or after the current time on the lowest level holds the next timer
+                for (int level = 0; level < LEVELS; ++level) {
+                    int index = int((current >> (SLOT_BITS * level)) & (SLOTS - 1));
+                    uint64_t mask = occupied[level] & (~uint64_t(0) << index);
+                    if (mask) {
+                        return earliest(slots[level][ctz(mask)]);
+                    }
+                }
+
+                return earliest(overflow);
+            }
+
+            /**
+             * @brief Removes every timer that expires at or before now from the wheel and passes it to the function.
+             *
+             * @details
+             *  The function is called with each expired timer after it has been removed, so it may insert the timer
+             *  again (for example to repeat it). Timers inserted again that have already expired are not passed to the
+             *  function again until the next call.
+             *
+             * @param now  the time to expire timers up to
+             * @param func the function to call with each expired timer
+             */
+            template <typename TFunc>
+            void expire(const clock::time_point& now, TFunc&& func) {
+
+                uint64_t target = ticks(now);
+
+                // With nothing to expire we can move straight to now
+                if (count == 0) {
+                    current = target < current ? current : target;
+                    return;
+                }
+
+                while (true) {
+
+                    // Take the timers in our current slot and expire the ones that are due
+                    int index = int(current & (SLOTS - 1));
+                    Timer* pending = nullptr;
+                    take(0, index, pending);
+
+                    while (pending) {
+                        Timer& timer = *pending;
+                        unlink(timer);
+                        --count;
+
+                        if (timer.when <= now) {
+                            func(timer);
+                        }
+                        else {
+                            insert(timer);
+                        }
+                    }
+
+                    if (current >= target) {
+                        break;
+                    }
+
+                    // Jump to the next occupied slot in this rotation if there is one
+                    uint64_t mask = index + 1 < SLOTS ? occupied[0] & (~uint64_t(0) << (index + 1)) : 0;
+                    uint64_t rotation = current & ~uint64_t(SLOTS - 1);
+
+                    if (mask && (rotation | uint64_t(ctz(mask))) <= target) {
+                        current = rotation | uint64_t(ctz(mask));
+                    }
+                    // Otherwise move to the start of the next rotation, cascading the higher levels down
+                    else if (!mask && rotation + SLOTS <= target) {
+                        current = rotation + SLOTS;
+                        cascade();
+                    }
+                    else {
+                        current = target;
+                    }
+                }
+            }
+
+        private:
+            /// @brief gets the tick that a time falls in
+            uint64_t ticks(const clock::time_point& time) const {
+                return time <= epoch ? 0 : uint64_t((time - epoch) / tick);
+            }
+
+            /// @brief adds a timer to the front of a list
+            static void link(Timer& timer, Timer*& head, int level, int slot) {
+                timer.next  = head;
+                timer.pprev = &head;
+                timer.level = level;
+                timer.slot  = slot;
+                if (head) {
+                    head->pprev = &timer.next;
+                }
+                head = &timer;
+            }
+
+            /// @brief removes a timer from whatever list it is in
+            static void unlink(Timer& timer) {
+                *timer.pprev = timer.next;
+                if (timer.next) {
+                    timer.next->pprev = timer.pprev;
+                }
+                timer.next  = nullptr;
+                timer.pprev = nullptr;
+            }
+
+            /// @brief moves the timers in a slot into the list head, leaving the slot empty
+            void take(int level, int slot, Timer*& head) {
+                head = slots[level][slot];
+                slots[level][slot] = nullptr;
+                occupied[level] &= ~(uint64_t(1) << slot);
+                if (head) {
+                    head->pprev = &head;
+                }
+            }
+
+            /// @brief reinserts all the timers in a list so they move to the level they now belong in
+            void reinsert(Timer*& head) {
+                while (head) {
+                    Timer& timer = *head;
+                    unlink(timer);
+                    --count;
+                    insert(timer);
+                }
+            }
+
+            /// @brief cascades the slots of the higher levels down when the current tick starts a new rotation
+            void cascade() {
+
+                // Find the highest level whose rotation we just finished
+                int top = 1;
+                while (top < LEVELS && ((current >> (SLOT_BITS * top)) & (SLOTS - 1)) == 0) {
+                    ++top;
+                }
+
+                // If every level wrapped around then our overflow timers may now be in range
+                if (top == LEVELS) {
+                    Timer* list = overflow;
+                    overflow = nullptr;
+                    if (list) {
+                        list->pprev = &list;
+                    }
+                    reinsert(list);
+                    top = LEVELS - 1;
+                }
+
+                // Move the timers in the slot we are now up to in each level down
+                for (int level = top; level > 0; --level) {
+                    Timer* list = nullptr;
+                    take(level, int((current >> (SLOT_BITS * level)) & (SLOTS - 1)), list);
+                    reinsert(list);
+                }
+            }
+
+            /// @brief finds the earliest timer in a list
+            static clock::time_point earliest(const Timer* timer) {
+                clock::time_point out = clock::time_point::max();
+                for (; timer != nullptr; timer = timer->next) {
+                    out = timer->when < out ? timer->when : out;
+                }
+                return out;
+            }
+
+            /// @brief counts the trailing zeros of a non zero value
+            static int ctz(uint64_t value) {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward64(&index, value);
+                return int(index);
+#else
+                return __builtin_ctzll(value);
+#endif
+            }
+
+            /// @brief the time that tick 0 starts at
+            clock::time_point epoch;
+            /// @brief the length of each tick
+            clock::duration tick;
+            /// @brief the tick that the wheel is currently up to
+            uint64_t current;
+            /// @brief the number of timers in the wheel
+            size_t count;
+            /// @brief a bitmap of the slots in each level that hold timers
+            std::array<uint64_t, LEVELS> occupied;
+            /// @brief the lists of timers in each slot of each level
+            std::array<std::array<Timer*, SLOTS>, LEVELS> slots;
+            /// @brief timers that are too far away to fit in the wheel
+            Timer* overflow;
+        };
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // NUCLEAR_UTIL_TIMINGWHEEL_HPP
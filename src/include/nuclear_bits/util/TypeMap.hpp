@@ -18,9 +18,11 @@
 #ifndef NUCLEAR_UTIL_TYPEMAP_HPP
 #define NUCLEAR_UTIL_TYPEMAP_HPP
 
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <thread>
 
 namespace NUClear {
     namespace util {
@@ -51,26 +53,93 @@ namespace NUClear {
             TypeMap() = delete;
             /// @brief Deleted destructor as this class is a static class.
             ~TypeMap() = delete;
-            /// @brief the data variable where the data is stored for this map key.
 
-            static std::shared_ptr<TValue> data;
-            static std::mutex mutex;
+            /**
+             * @brief A slot a value can be published from, along with the count of readers that have finished with it
+             *        since it was replaced.
+             */
+            struct Buffer {
+                constexpr Buffer() : value(), released(0), used(false) {}
+
+                /// @brief the value that was stored
+                std::shared_ptr<TValue> value;
+                /// @brief readers that released this buffer after it was replaced, less the readers that held it then
+                std::atomic<int64_t> released;
+                /// @brief if a writer has claimed this buffer and it hasn't been released by all its readers yet
+                std::atomic<bool> used;
+            };
+
+            /// @brief the number of buffers, more than are ever held at once unless readers are preempted mid read
+            static constexpr size_t BUFFERS = 8;
+
+            /**
+             * @brief The head holds the current buffer in its low 32 bits and the count of its readers in the high 32.
+             *
+             * @details
+             *  Readers register themselves and find the buffer with a single fetch_add. This is the split reference
+             *  count scheme, readers add to the shared count here, and when the buffer is replaced the writer moves
+             *  that count onto the buffer so that the last of those readers to finish can free it for reuse. As this
+             *  holds an index rather than a pointer it doesn't depend on how many bits an address uses.
+             */
+            static constexpr uint64_t COUNT_ONE  = uint64_t(1) << 32;
+            static constexpr uint64_t INDEX_MASK = COUNT_ONE - 1;
+            /// @brief the index held by the head before anything has been stored
+            static constexpr uint64_t EMPTY = INDEX_MASK;
+
+            /// @brief Claims a buffer that no other writer or reader is using.
+            static size_t claim() {
+                for(size_t i = 0;; i = (i + 1) % BUFFERS) {
+                    bool expected = false;
+                    if(!buffers[i].used.load(std::memory_order_relaxed)
+                       && buffers[i].used.compare_exchange_strong(
+                              expected, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+                        return i;
+                    }
+
+                    // Every buffer is busy with another writer or a reader that is yet to finish
+                    if(i == BUFFERS - 1) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            /// @brief Releases readers from a buffer that has been replaced, freeing it once they are all gone.
+            static void release(size_t i, int64_t count) {
+                if (buffers[i].released.fetch_add(count, std::memory_order_acq_rel) + count == 0) {
+                    buffers[i].value.reset();
+                    buffers[i].used.store(false, std::memory_order_release);
+                }
+            }
+
+            /// @brief the index of the current buffer and the count of readers that are using it
+            static std::atomic<uint64_t> head;
+            /// @brief the buffers that values are published from
+            static std::array<Buffer, BUFFERS> buffers;
+            /// @brief the number of times the data in this map has been set
+            static std::atomic<uint64_t> revision;
 
         public:
             /**
              * @brief Stores the passed value in this map.
              *
+             * @details
+             *  The value is moved into a free buffer and published with a single atomic exchange, readers never wait
+             *  on a lock to access it. A writer only waits if every buffer is still held, which takes several readers
+             *  being preempted part way through a get.
+             *
              * @param d a pointer to the data to be stored (the map takes ownership)
              */
             static void set(std::shared_ptr<TValue> d) {
+                size_t i         = claim();
+                buffers[i].value = std::move(d);
 
-                // Do this once G++ supports it
-                //std::atomic_store_explicit(&data, d, std::memory_order_relaxed);
-
-                // Lock a mutex and set our data
-                std::lock_guard<std::mutex> lock(mutex);
-                data = std::move(d);
+                uint64_t old = head.exchange(i, std::memory_order_acq_rel);
+                revision.fetch_add(1, std::memory_order_release);
 
+                // The readers that were part way through a get when we swapped will release the old buffer themselves
+                if ((old & INDEX_MASK) != EMPTY) {
+                    release(old & INDEX_MASK, -int64_t(old >> 32));
+                }
             }
 
             /**
@@ -80,24 +149,51 @@ namespace NUClear {
              */
             static std::shared_ptr<TValue> get() {
 
-                // TODO do this when gcc supports it
-                // std::atomic_load_explicit(&data, std::memory_order_relaxed);
+                // Register ourselves as a reader of the current buffer, it can't be reused until we let it go
+                uint64_t word = head.fetch_add(COUNT_ONE, std::memory_order_acq_rel) + COUNT_ONE;
+                size_t i      = word & INDEX_MASK;
 
-                std::shared_ptr<TValue> d;
-                {
-                    std::lock_guard<std::mutex> lock(mutex);
-                    d = data;
+                if (i == EMPTY) {
+                    return nullptr;
                 }
 
-                return d;
+                std::shared_ptr<TValue> value = buffers[i].value;
+
+                // Give our count back, if the buffer was replaced in the mean time the writer has moved it onto it
+                while (!head.compare_exchange_weak(
+                    word, word - COUNT_ONE, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    if ((word & INDEX_MASK) != i) {
+                        release(i, 1);
+                        break;
+                    }
+                }
+
+                return value;
+            }
+
+            /**
+             * @brief Gets the version of the value that is currently stored.
+             *
+             * @details
+             *  The version starts at 0 (before anything is stored) and increases by one every time the value is set.
+             *  If the version has not changed then the stored value has not changed either, so it can be used to skip
+             *  reloading or reprocessing data that has already been seen.
+             *
+             * @return the number of times a value has been stored in this map
+             */
+            static uint64_t version() {
+                return revision.load(std::memory_order_acquire);
             }
         };
 
-        /// Initialize our shared_ptr data
+        /// Initialize our data
+        template <typename TMapID, typename TKey, typename TValue>
+        std::atomic<uint64_t> TypeMap<TMapID, TKey, TValue>::head(TypeMap<TMapID, TKey, TValue>::EMPTY);
         template <typename TMapID, typename TKey, typename TValue>
-        std::shared_ptr<TValue> TypeMap<TMapID, TKey, TValue>::data;
+        std::array<typename TypeMap<TMapID, TKey, TValue>::Buffer, TypeMap<TMapID, TKey, TValue>::BUFFERS>
+            TypeMap<TMapID, TKey, TValue>::buffers;
         template <typename TMapID, typename TKey, typename TValue>
-        std::mutex TypeMap<TMapID, TKey, TValue>::mutex;
+        std::atomic<uint64_t> TypeMap<TMapID, TKey, TValue>::revision(0);
 
     }  // namespace util
 }  //  namespace NUClear
@@ -19,24 +19,16 @@
 #define NUCLEAR_UTIL_GET_IDENTIFIER_HPP
 
 #include <string>
-#include <vector>
+#include <typeinfo>
 
-#include "nuclear_bits/util/demangle.hpp"
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
 
 namespace NUClear {
     namespace util {
 
         template <typename TFusion, typename TFunc>
-        std::vector<std::string> get_identifier(std::string usr, std::string reactor) {
-
-            std::vector<std::string> out = {
-                usr,
-                reactor,
-                demangle(typeid(TFusion).name()),
-                demangle(typeid(TFunc).name())
-            };
-
-            return out;
+        ReactionIdentifier get_identifier(const std::string& usr, const std::string& reactor) {
+            return ReactionIdentifier(usr, reactor, typeid(TFusion), typeid(TFunc));
         }
 
     }  // namespace util
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NUCLEAR_UTIL_NETWORK_SENDERSOCKETS_HPP
+#define NUCLEAR_UTIL_NETWORK_SENDERSOCKETS_HPP
+
+#ifdef _WIN32
+    #include "nuclear_bits/util/windows_includes.hpp"
+#else
+    #include <netinet/in.h>
+#endif
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "nuclear_bits/util/platform.hpp"
+
+namespace NUClear {
+    namespace util {
+        namespace network {
+
+            /**
+             * @brief The sockets that UDP emits send from, kept open so that every emit doesn't make its own.
+             *
+             * @details
+             *  A socket that sends from any port is made the first time it is needed and is then shared by every emit
+             *  that sends from the same address through the same multicast interface. A socket that sends from a
+             *  specific port is made for the emit that asked for it and is closed when it is done, so that the port
+             *  can be bound by something else (such as a UDP reaction) afterwards.
+             */
+            class SenderSockets {
+            public:
+                /// @brief a socket to send from, which is closed when it is destroyed unless it is one we share
+                struct Sender {
+                    Sender(fd_t fd, bool owned);
+                    Sender(Sender&& other);
+                    ~Sender();
+
+                    Sender(const Sender&) = delete;
+                    Sender& operator=(const Sender&) = delete;
+                    Sender& operator=(Sender&&) = delete;
+
+                    operator fd_t() const;
+
+                    /// @brief the socket to send from
+                    fd_t fd;
+                    /// @brief if this socket is only used by this sender
+                    bool owned;
+                };
+
+                SenderSockets();
+                ~SenderSockets();
+
+                SenderSockets(const SenderSockets&) = delete;
+                SenderSockets& operator=(const SenderSockets&) = delete;
+
+                /**
+                 * @brief Gets a socket to send from, making it if it isn't one we share or it hasn't been asked for yet.
+                 *
+                 * @param fromAddr              the address to send from in host byte order, or INADDR_ANY
+                 * @param fromPort              the port to send from, or 0 for any port
+                 * @param multicastInterface    the interface to send multicast on in host byte order, or INADDR_ANY
+                 *
+                 * @return the socket, if it was sending from a specific port it is closed when this is destroyed
+                 */
+                Sender get(in_addr_t fromAddr, in_port_t fromPort, in_addr_t multicastInterface);
+
+                /// @brief the sockets UDP emits use, they are never destroyed so emits can happen while we shut down
+                static SenderSockets& instance();
+
+            private:
+                std::mutex mutex;
+                std::map<std::tuple<in_addr_t, in_port_t, in_addr_t>, fd_t> sockets;
+            };
+
+            /**
+             * @brief Sends datagrams to a single target, as few system calls as possible are used.
+             *
+             * @details
+             *  On Linux the datagrams are sent with sendmmsg, which sends up to UIO_MAXIOV of them in a single call.
+             *  Elsewhere each datagram is sent with its own sendto.
+             *
+             * @param fd        the socket to send from
+             * @param target    the address to send the datagrams to
+             * @param datagrams the payloads of the datagrams
+             */
+            void send_datagrams(fd_t fd, const sockaddr_in& target, const std::vector<std::vector<char>>& datagrams);
+
+        }  // namespace network
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // NUCLEAR_UTIL_NETWORK_SENDERSOCKETS_HPP
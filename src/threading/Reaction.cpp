@@ -23,17 +23,60 @@ namespace NUClear {
         // Initialize our reaction source
         std::atomic<uint64_t> Reaction::reactionIdSource(0);
 
+        Reaction::Registry& Reaction::registry() {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
         Reaction::Reaction(Reactor& reactor
-                           , std::vector<std::string> identifier
-                           , std::function<std::pair<int, std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)>> (Reaction&)> generator
+                           , util::ReactionIdentifier identifier
+                           , std::function<std::pair<int, ReactionTask::TaskFunction> (Reaction&)> generator
                            , std::function<void (Reaction&)>&& unbinder)
           : reactor(reactor)
           , identifier(identifier)
           , reactionId(++reactionIdSource)
           , activeTasks(0)
           , enabled(true)
+          , statistics(true)
+          , taskCount(0)
+          , throttleTime(0)
+          , throttled(0)
+          , throttledInterval(0)
+          , queueLatency()
+          , runLatency()
           , generator(generator)
           , unbinder(unbinder) {
+
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.reactions.insert(this);
+        }
+
+        Reaction::~Reaction() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.reactions.erase(this);
+        }
+
+        void Reaction::snapshotHistograms(message::ReactionHistogramSnapshot& snapshot) {
+
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            for (auto& reaction : reg.reactions) {
+
+                message::ReactionHistogramSnapshot::Reaction r;
+                r.queue = reaction->queueLatency.snapshot(true);
+                r.run   = reaction->runLatency.snapshot(true);
+                r.throttled = reaction->throttledInterval.exchange(0, std::memory_order_relaxed);
+
+                // Only include reactions that finished tasks or were throttled in this interval
+                if (r.run.count > 0 || r.throttled > 0) {
+                    r.identifier = reaction->identifier;
+                    r.reactionId = reaction->reactionId;
+                    snapshot.reactions.push_back(std::move(r));
+                }
+            }
         }
 
         void Reaction::unbind() {
@@ -50,12 +93,12 @@ namespace NUClear {
 
             // Run our generator to get a functor we can run
             int priority;
-            std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)> func;
+            ReactionTask::TaskFunction func;
             std::tie(priority, func) = generator(*this);
 
             // If our generator returns a valid function
             if(func) {
-                return std::unique_ptr<ReactionTask>(new ReactionTask(*this, priority, func));
+                return std::unique_ptr<ReactionTask>(new ReactionTask(*this, priority, std::move(func)));
             }
             // Otherwise we return a null pointer
             else {
@@ -52,6 +52,19 @@ namespace NUClear {
             return *this;
         }
 
+        ReactionHandle& ReactionHandle::enableStatistics(bool set) {
+            auto c = context.lock();
+            if(c) {
+                c->statistics = set;
+            }
+            return *this;
+        }
+
+        uint64_t ReactionHandle::throttled() {
+            auto c = context.lock();
+            return c ? uint64_t(c->throttled) : 0;
+        }
+
         void ReactionHandle::unbind() {
             auto c = context.lock();
             if(c) {
@@ -17,6 +17,8 @@
 
 #include "nuclear_bits/threading/ReactionTask.hpp"
 #include "nuclear_bits/threading/Reaction.hpp"
+#include "nuclear_bits/PowerPlant.hpp"
+#include "nuclear_bits/dsl/store/TypeCallbackStore.hpp"
 
 namespace NUClear {
     namespace threading {
@@ -31,22 +33,38 @@ namespace NUClear {
         // Initialize our current task
         ATTRIBUTE_TLS ReactionTask* ReactionTask::currentTask = nullptr;
 
-        ReactionTask::ReactionTask(Reaction& parent, int priority, std::function<std::unique_ptr<ReactionTask> (std::unique_ptr<ReactionTask>&&)> callback)
+        namespace {
+            // Statistics are only worth collecting if someone will receive them
+            bool collectStatistics(Reaction& parent) {
+
+                // Check our reaction wants statistics and that someone is listening for them
+                if(!parent.statistics || dsl::store::TypeCallbackStore<message::ReactionStatistics>::get().empty()) {
+                    return false;
+                }
+
+                // Sample one in every N tasks of this reaction
+                size_t rate = PowerPlant::powerplant ? PowerPlant::powerplant->configuration.statisticsSampleRate : 1;
+                return rate <= 1 || parent.taskCount++ % rate == 0;
+            }
+        }
+
+        ReactionTask::ReactionTask(Reaction& parent, int priority, TaskFunction&& callback)
           : parent(parent)
           , taskId(++taskIdSource)
           , priority(priority)
-          , stats(new message::ReactionStatistics {
+          , emitted(clock::now())
+          , stats(!collectStatistics(parent) ? nullptr : new message::ReactionStatistics {
                 parent.identifier
               , parent.reactionId
               , taskId
               , currentTask ? currentTask->parent.reactionId : 0
               , currentTask ? currentTask->taskId : 0
-              , clock::now()
+              , emitted
               , clock::time_point(std::chrono::seconds(0))
               , clock::time_point(std::chrono::seconds(0))
               , nullptr
             })
-          , callback(callback) {
+          , callback(std::move(callback)) {
 
             // There is one new active task
             ++parent.activeTasks;
@@ -63,12 +81,14 @@ namespace NUClear {
             currentTask = this;
 
             // Run our callback at catch the returned task (to see if it rescheduled itself)
+            auto started = clock::now();
             us = callback(std::move(us));
 
             // If we were not rescheduled then finish off our stats
             if(us) {
-                // There is one less task
-                --parent.activeTasks;
+                // Record how long we waited to run and how long we ran for, the callback has already said it isn't active
+                parent.queueLatency.record(started - emitted);
+                parent.runLatency.record(clock::now() - started);
             }
 
             // Reset our task back
@@ -21,7 +21,7 @@ namespace NUClear {
     namespace threading {
 
         TaskScheduler::TaskScheduler()
-          : running(true), queue(), mutex(), condition() {}
+          : running(true), queue(), mutex(), condition(), waiting(0), waitCallback() {}
 
         TaskScheduler::~TaskScheduler() {
         }
@@ -49,6 +49,28 @@ namespace NUClear {
             condition.notify_one();
         }
 
+        void TaskScheduler::submit(std::vector<std::unique_ptr<ReactionTask>>&& tasks) {
+
+            // We do not accept new tasks once we are shutdown
+            if(running && !tasks.empty()) {
+
+                /* Mutex Scope */ {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for(auto& task : tasks) {
+                        queue.push(std::move(task));
+                    }
+                }
+
+                // Notify as many threads as we have new tasks
+                if(tasks.size() > 1) {
+                    condition.notify_all();
+                }
+                else {
+                    condition.notify_one();
+                }
+            }
+        }
+
         std::unique_ptr<ReactionTask> TaskScheduler::getTask() {
 
             //Obtain the lock
@@ -67,8 +89,21 @@ namespace NUClear {
                     return nullptr;
                 }
                 else {
+                    ++waiting;
+
+                    // Let anyone who cares know we ran out of work, without our lock so they can check on us
+                    if (waitCallback) {
+                        lock.unlock();
+                        waitCallback();
+                        lock.lock();
+                    }
+
                     // Wait for something to happen!
-                    condition.wait(lock);
+                    if (queue.empty() && running) {
+                        condition.wait(lock);
+                    }
+
+                    --waiting;
                 }
             }
 
@@ -81,5 +116,15 @@ namespace NUClear {
             return task;
 
         }
+
+        bool TaskScheduler::idle(size_t threads) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return queue.empty() && waiting == threads;
+        }
+
+        void TaskScheduler::onWait(std::function<void ()>&& func) {
+            std::lock_guard<std::mutex> lock(mutex);
+            waitCallback = std::move(func);
+        }
     }
 }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nuclear_bits/util/BufferPool.hpp"
+
+#include <new>
+
+namespace NUClear {
+    namespace util {
+
+        constexpr size_t BufferPool::MIN_BLOCK_SIZE;
+
+        BufferPool::BufferPool(size_t blockSize) : blockSize(blockSize), mutex(), available(sizeClass(blockSize) + 1), count(0) {}
+
+        BufferPool::~BufferPool() {
+            for(auto& blocks : available) {
+                for(auto block : blocks) {
+                    block->~Block();
+                    ::operator delete(block);
+                }
+            }
+        }
+
+        size_t BufferPool::sizeClass(size_t size) const {
+            size_t c = 0;
+            for(size_t s = MIN_BLOCK_SIZE; s < size && s < blockSize; s <<= 1) {
+                ++c;
+            }
+            return c;
+        }
+
+        BufferPool::Buffer BufferPool::acquire() {
+            return acquire(blockSize);
+        }
+
+        BufferPool::Buffer BufferPool::acquire(size_t size) {
+            size_t c = sizeClass(size);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!available[c].empty()) {
+                    Block* block = available[c].back();
+                    available[c].pop_back();
+                    block->references.store(1, std::memory_order_relaxed);
+                    return Buffer(block);
+                }
+                ++count;
+            }
+
+            // The data goes straight after the block, blocks are aligned enough for any data we will put in them
+            size_t bytes = (MIN_BLOCK_SIZE << c) < blockSize ? (MIN_BLOCK_SIZE << c) : blockSize;
+            return Buffer(new (::operator new(sizeof(Block) + bytes)) Block(*this, bytes));
+        }
+
+        size_t BufferPool::allocated() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return count;
+        }
+
+        void BufferPool::recycle(Block* block) {
+            size_t c = sizeClass(block->size);
+            std::lock_guard<std::mutex> lock(mutex);
+            available[c].push_back(block);
+        }
+
+    }  // namespace util
+}  // namespace NUClear
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// io_uring only exists on linux
+#ifdef __linux__
+
+#include "nuclear_bits/util/IOUring.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace NUClear {
+    namespace util {
+
+        namespace {
+            template <typename T>
+            T* offset(void* base, unsigned off) {
+                return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+            }
+        }
+
+        IOUring::IOUring(unsigned entries)
+        : fd(-1)
+        , sqRing(MAP_FAILED)
+        , sqRingSize(0)
+        , cqRing(MAP_FAILED)
+        , cqRingSize(0)
+        , sqes(static_cast<io_uring_sqe*>(MAP_FAILED))
+        , sqesSize(0)
+        , sqHead(nullptr)
+        , sqTail(nullptr)
+        , sqMask(nullptr)
+        , sqArray(nullptr)
+        , sqEntries(0)
+        , cqHead(nullptr)
+        , cqTail(nullptr)
+        , cqMask(nullptr)
+        , cqes(nullptr)
+        , tail(0)
+        , unsubmitted(0) {
+
+#ifdef __NR_io_uring_setup
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+
+            fd = int(syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                throw std::system_error(errno, std::system_category(), "We were unable to set up an io_uring");
+            }
+
+            sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            sqesSize   = params.sq_entries * sizeof(io_uring_sqe);
+
+            // Newer kernels let us map both rings at once
+            bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single) {
+                sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+            }
+
+            sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sqRing != MAP_FAILED) {
+                cqRing = single ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            }
+            if (cqRing != MAP_FAILED) {
+                sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+            }
+
+            if (sqes == MAP_FAILED) {
+                int error = errno;
+                release();
+                throw std::system_error(error, std::system_category(), "We were unable to map the io_uring queues");
+            }
+
+            sqHead    = offset<unsigned>(sqRing, params.sq_off.head);
+            sqTail    = offset<unsigned>(sqRing, params.sq_off.tail);
+            sqMask    = offset<unsigned>(sqRing, params.sq_off.ring_mask);
+            sqArray   = offset<unsigned>(sqRing, params.sq_off.array);
+            sqEntries = params.sq_entries;
+
+            cqHead = offset<unsigned>(cqRing, params.cq_off.head);
+            cqTail = offset<unsigned>(cqRing, params.cq_off.tail);
+            cqMask = offset<unsigned>(cqRing, params.cq_off.ring_mask);
+            cqes   = offset<io_uring_cqe>(cqRing, params.cq_off.cqes);
+
+            tail = *sqTail;
+#else
+            (void) entries;
+            throw std::system_error(ENOSYS, std::system_category(), "This system was built without io_uring");
+#endif
+        }
+
+        IOUring::~IOUring() {
+            release();
+        }
+
+        void IOUring::release() {
+            if (sqes != MAP_FAILED) {
+                munmap(sqes, sqesSize);
+            }
+            if (cqRing != MAP_FAILED && cqRing != sqRing) {
+                munmap(cqRing, cqRingSize);
+            }
+            if (sqRing != MAP_FAILED) {
+                munmap(sqRing, sqRingSize);
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+
+        io_uring_sqe* IOUring::next() {
+
+            // If the queue is full, hand what we have to the kernel
+            while (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+                unsigned before = unsubmitted + (tail - *sqTail);
+                int error = submit(0);
+
+                // A full completion queue or a lack of resources only clears once completions are reaped, which our
+                // caller has to do, so only retry straight away if we were interrupted
+                if (error != 0 ? error != EINTR : unsubmitted == before) {
+                    return nullptr;
+                }
+            }
+
+            unsigned index = tail & *sqMask;
+            sqArray[index] = index;
+            ++tail;
+
+            io_uring_sqe* sqe = &sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        bool IOUring::enter(unsigned waitFor) {
+            return submit(waitFor) == 0 && unsubmitted == 0;
+        }
+
+        int IOUring::submit(unsigned waitFor) {
+
+            // Publish our new entries
+            unsubmitted += tail - *sqTail;
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+#ifdef __NR_io_uring_enter
+            int result = int(syscall(__NR_io_uring_enter, fd, unsubmitted, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+            if (result < 0) {
+                // We were interrupted or the completion queue is full, either way the caller will reap and come back
+                if (errno == EINTR || errno == EBUSY || errno == EAGAIN) {
+                    return errno;
+                }
+                throw std::system_error(errno, std::system_category(), "There was an error entering the io_uring");
+            }
+
+            unsubmitted -= unsigned(result);
+            return 0;
+#else
+            (void) waitFor;
+            return ENOSYS;
+#endif
+        }
+
+    }  // namespace util
+}  // namespace NUClear
+
+#endif  // __linux__
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nuclear_bits/util/ReactionIdentifier.hpp"
+
+#include "nuclear_bits/util/demangle.hpp"
+
+namespace NUClear {
+    namespace util {
+
+        ReactionIdentifier::ReactionIdentifier() : names() {}
+
+        ReactionIdentifier::ReactionIdentifier(const std::string& label
+                                             , const std::string& reactor
+                                             , const std::type_info& dsl
+                                             , const std::type_info& function)
+        : names(std::make_shared<Names>(label, reactor, dsl.name(), function.name())) {}
+
+        const std::vector<std::string>& ReactionIdentifier::get() const {
+
+            static const std::vector<std::string> empty;
+
+            if (!names) {
+                return empty;
+            }
+
+            // Demangle our type names the first time someone looks at them
+            std::call_once(names->demangled, [this] {
+                names->strings.push_back(demangle(names->dsl));
+                names->strings.push_back(demangle(names->function));
+            });
+
+            return names->strings;
+        }
+
+    }  // namespace util
+}  // namespace NUClear
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nuclear_bits/util/network/SenderSockets.hpp"
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <sys/socket.h>
+    #include <arpa/inet.h>
+    #include <sys/uio.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#include "nuclear_bits/util/FileDescriptor.hpp"
+
+namespace NUClear {
+    namespace util {
+        namespace network {
+
+            SenderSockets::Sender::Sender(fd_t fd, bool owned) : fd(fd), owned(owned) {}
+
+            SenderSockets::Sender::Sender(Sender&& other) : fd(other.fd), owned(other.owned) {
+                other.owned = false;
+            }
+
+            SenderSockets::Sender::~Sender() {
+                if(owned) {
+                    close(fd);
+                }
+            }
+
+            SenderSockets::Sender::operator fd_t() const {
+                return fd;
+            }
+
+            SenderSockets::SenderSockets() : mutex(), sockets() {}
+
+            SenderSockets::~SenderSockets() {
+                for(auto& socket : sockets) {
+                    close(socket.second);
+                }
+            }
+
+            SenderSockets::Sender SenderSockets::get(in_addr_t fromAddr, in_port_t fromPort, in_addr_t multicastInterface) {
+
+                // Sockets on a specific port would hold it forever if we kept them, so they are only used once
+                bool shared = fromPort == 0;
+
+                std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+                auto key = std::make_tuple(fromAddr, fromPort, multicastInterface);
+                if(shared) {
+                    lock.lock();
+
+                    // We already have one
+                    auto it = sockets.find(key);
+                    if(it != sockets.end()) {
+                        return Sender(it->second, false);
+                    }
+                }
+
+                // Open a socket to send the datagrams from
+                util::FileDescriptor fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+                if(fd < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "We were unable to open the UDP socket");
+                }
+
+                sockaddr_in src;
+                memset(&src, 0, sizeof(sockaddr_in));
+                src.sin_family = AF_INET;
+                src.sin_addr.s_addr = htonl(fromAddr);
+                src.sin_port = htons(fromPort);
+
+                // If we need to, bind to a port on our end
+                if(fromAddr != INADDR_ANY || fromPort != 0) {
+                    if(::bind(fd, reinterpret_cast<sockaddr*>(&src), sizeof(sockaddr))) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to bind the UDP socket to the port");
+                    }
+                }
+
+                // If we have a specific interface for multicast we need to tell the system to use it
+                if(multicastInterface != INADDR_ANY) {
+                    in_addr iface;
+                    iface.s_addr = htonl(multicastInterface);
+                    if(setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, reinterpret_cast<const char*>(&iface), sizeof(iface)) < 0) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to use the requested interface for multicast");
+                    }
+                }
+
+                // This isn't the greatest code, but lets assume our users don't send broadcasts they don't mean to...
+                int yes = true;
+                if(setsockopt(fd, SOL_SOCKET, SO_BROADCAST, reinterpret_cast<const char*>(&yes), sizeof(yes)) < 0) {
+                    throw std::system_error(network_errno, std::system_category(), "We were unable to enable broadcasting on this socket");
+                }
+
+                fd_t socket = fd.release();
+                if(shared) {
+                    sockets.insert(std::make_pair(key, socket));
+                }
+                return Sender(socket, !shared);
+            }
+
+            SenderSockets& SenderSockets::instance() {
+                static SenderSockets* sockets = new SenderSockets();
+                return *sockets;
+            }
+
+            void send_datagrams(fd_t fd, const sockaddr_in& target, const std::vector<std::vector<char>>& datagrams) {
+
+                #ifdef __linux__
+                std::vector<iovec> payloads(datagrams.size());
+                std::vector<mmsghdr> messages(datagrams.size());
+                for(size_t i = 0; i < datagrams.size(); ++i) {
+                    payloads[i].iov_base = const_cast<char*>(datagrams[i].data());
+                    payloads[i].iov_len = datagrams[i].size();
+
+                    msghdr& mh = messages[i].msg_hdr;
+                    memset(&mh, 0, sizeof(msghdr));
+                    mh.msg_name = const_cast<sockaddr_in*>(&target);
+                    mh.msg_namelen = sizeof(sockaddr_in);
+                    mh.msg_iov = &payloads[i];
+                    mh.msg_iovlen = 1;
+                }
+
+                // sendmmsg can send fewer than we asked it to, so keep going until they are all gone
+                for(size_t sent = 0; sent < datagrams.size();) {
+                    unsigned int count = static_cast<unsigned int>(std::min<size_t>(datagrams.size() - sent, UIO_MAXIOV));
+                    int result = ::sendmmsg(fd, messages.data() + sent, count, 0);
+                    if(result < 0) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to send the UDP messages");
+                    }
+                    sent += size_t(result);
+                }
+                #else
+                for(auto& data : datagrams) {
+                    if(::sendto(fd, data.data(), data.size(), 0, reinterpret_cast<const sockaddr*>(&target), sizeof(sockaddr_in)) < 0) {
+                        throw std::system_error(network_errno, std::system_category(), "We were unable to send the UDP message");
+                    }
+                }
+                #endif
+            }
+
+        }  // namespace network
+    }  // namespace util
+}  // namespace NUClear
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include "nuclear"
+
+// Anonymous namespace to keep everything file local
+namespace {
+
+    int wakeups = 0;
+    NUClear::clock::time_point lastTarget;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<NUClear::message::ChronoWakeup>>().then([this] (const NUClear::message::ChronoWakeup& wakeup) {
+
+                // We always busy wait until the target so we can't be early
+                REQUIRE(wakeup.lateness >= NUClear::clock::duration(0));
+                REQUIRE(wakeup.sleepError >= NUClear::clock::duration(0));
+                REQUIRE(wakeup.target - wakeup.wake == std::chrono::milliseconds(1));
+                REQUIRE(wakeup.target > lastTarget);
+                lastTarget = wakeup.target;
+
+                if (++wakeups == 20) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Every<5, std::chrono::milliseconds>>().then([] {});
+
+            on<Startup>().then([this] {
+                emit<Scope::DIRECT>(std::make_unique<NUClear::message::ChronoConfiguration>(std::chrono::milliseconds(1)));
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing the chrono controller spin window and wakeup reports", "[api][chrono]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.histogramPeriod = NUClear::clock::duration(0);
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    REQUIRE(wakeups == 20);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <catch.hpp>
+
+#include "nuclear"
+
+// Anonymous namespace to keep everything file local
+namespace {
+
+    using NUClear::clock;
+
+    constexpr size_t NUM_TICKS = 60;
+
+    std::vector<clock::time_point> times;
+    std::vector<clock::time_point> statsTimes;
+
+    class FastForwardReactor : public NUClear::Reactor {
+    public:
+
+        FastForwardReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            // Ten minutes of ticks
+            on<Every<10, std::chrono::seconds>>().then("Tick", [this] {
+
+                // Ticks that were already queued when we shut down still run, so only count the ones before it
+                if (times.size() <= NUM_TICKS) {
+                    times.push_back(clock::now());
+
+                    if (times.size() > NUM_TICKS) {
+                        powerplant.shutdown();
+                    }
+                }
+            });
+
+            on<Trigger<NUClear::message::ReactionStatistics>>().then([] (const NUClear::message::ReactionStatistics& stats) {
+                if (stats.identifier[0] == "Tick") {
+                    statsTimes.push_back(stats.started);
+                }
+            });
+        }
+    };
+
+    class AcceleratedReactor : public NUClear::Reactor {
+    public:
+
+        AcceleratedReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Every<100, std::chrono::milliseconds>>().then([this] {
+
+                // Ticks that were already queued when we shut down still run, so only count the ones before it
+                if (times.size() <= NUM_TICKS) {
+                    times.push_back(clock::now());
+
+                    if (times.size() > NUM_TICKS) {
+                        powerplant.shutdown();
+                    }
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing the virtual clock can be set and advanced", "[api][clock]") {
+
+    clock::time_point start(std::chrono::hours(1));
+
+    clock::set(start, 0.0);
+    REQUIRE(clock::now() == start);
+    REQUIRE(clock::rate() == 0.0);
+    REQUIRE(clock::real(std::chrono::seconds(1)) == clock::duration::max());
+
+    clock::advance(std::chrono::seconds(5));
+    REQUIRE(clock::now() == start + std::chrono::seconds(5));
+
+    // A stopped clock never gets to a time on the base clock
+    REQUIRE(clock::base(start + std::chrono::seconds(10)) == clock::time_point::max());
+
+    // At double speed ten seconds from now on our clock is five seconds from now on the base clock
+    clock::set(start, 2.0);
+    auto before = clock::base_clock::now();
+    auto wake = clock::base(clock::now() + std::chrono::seconds(10)) - before;
+    REQUIRE(wake > std::chrono::milliseconds(4999));
+    REQUIRE(wake < std::chrono::milliseconds(5100));
+
+    clock::reset();
+    REQUIRE(clock::rate() == 1.0);
+    REQUIRE(clock::real(std::chrono::seconds(1)) == std::chrono::seconds(1));
+    REQUIRE(clock::now() > start + std::chrono::hours(24));
+    REQUIRE(clock::base(start) == start);
+}
+
+TEST_CASE("Testing a fast forwarded clock runs Every reactions as fast as the pool drains", "[api][clock][every]") {
+
+    times.clear();
+    statsTimes.clear();
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.clockRate = 0.0;
+    config.fastForward = true;
+
+    auto start = clock::base_clock::now();
+    {
+        NUClear::PowerPlant plant(config);
+        plant.install<FastForwardReactor>();
+        plant.start();
+    }
+
+    // Ten minutes of virtual time should not take anywhere near that long
+    REQUIRE(clock::base_clock::now() - start < std::chrono::seconds(10));
+
+    // Nothing else was running, so every tick happened exactly on time
+    REQUIRE(times.size() == NUM_TICKS + 1);
+    for (size_t i = 0; i < times.size() - 1; ++i) {
+        REQUIRE(times[i + 1] - times[i] == std::chrono::seconds(10));
+    }
+
+    // Statistics follow the virtual clock too
+    REQUIRE(statsTimes.size() > 2);
+    REQUIRE(statsTimes.back() - statsTimes.front() >= std::chrono::seconds(10 * (statsTimes.size() - 1)));
+
+    // The clock is put back when the powerplant is gone
+    REQUIRE(clock::rate() == 1.0);
+}
+
+TEST_CASE("Testing an accelerated clock runs Every reactions faster than real time", "[api][clock][every]") {
+
+    times.clear();
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.clockRate = 100.0;
+
+    auto start = clock::base_clock::now();
+    {
+        NUClear::PowerPlant plant(config);
+        plant.install<AcceleratedReactor>();
+        plant.start();
+    }
+
+    // Six seconds of virtual time in a small fraction of that
+    REQUIRE(clock::base_clock::now() - start < std::chrono::seconds(3));
+
+    // On average we should still be ticking at our virtual rate
+    REQUIRE(times.size() == NUM_TICKS + 1);
+    auto mean = (times.back() - times.front()) / NUM_TICKS;
+    REQUIRE(mean > std::chrono::milliseconds(90));
+    REQUIRE(mean < std::chrono::milliseconds(110));
+}
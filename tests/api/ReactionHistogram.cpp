@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <thread>
+
+#include "nuclear"
+
+// Anonymous namespace to keep everything file local
+namespace {
+
+    struct Work {};
+
+    constexpr int WORK_COUNT = 10;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<Work>>().then("Work Handler", [this] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            });
+
+            on<Trigger<NUClear::message::ReactionHistogramSnapshot>>().then([this] (const NUClear::message::ReactionHistogramSnapshot& snapshot) {
+
+                REQUIRE(snapshot.start < snapshot.end);
+
+                for (auto& reaction : snapshot.reactions) {
+                    if (reaction.identifier[0] == "Work Handler") {
+
+                        // All of our work should be in this one interval
+                        REQUIRE(reaction.run.count == WORK_COUNT);
+                        REQUIRE(reaction.queue.count == WORK_COUNT);
+                        REQUIRE(reaction.run.percentile(50) >= std::chrono::milliseconds(2));
+                        REQUIRE(reaction.run.percentile(99.9) >= reaction.run.percentile(50));
+
+                        powerplant.shutdown();
+                    }
+                }
+            });
+
+            on<Startup>().then([this] {
+                for (int i = 0; i < WORK_COUNT; ++i) {
+                    emit(std::make_unique<Work>());
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing reaction latency histogram snapshots", "[api][reactionhistogram]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.histogramPeriod = std::chrono::milliseconds(100);
+    NUClear::PowerPlant plant(config);
+
+    plant.install<TestReactor>();
+
+    plant.start();
+}
@@ -86,3 +86,58 @@ TEST_CASE("Testing reaction statistics functionality", "[api][reactionstatistics
 
     plant.start();
 }
+
+namespace {
+
+    struct Counted {};
+
+    int countedTasks = 0;
+    int countedStats = 0;
+    int quietTasks = 0;
+
+    class SamplingReactor : public NUClear::Reactor {
+    public:
+
+        SamplingReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<NUClear::message::ReactionStatistics>>().then([this] (const NUClear::message::ReactionStatistics& stats) {
+                if (stats.identifier[0] == "Counted Handler") {
+                    ++countedStats;
+                }
+                // The quiet handler turned off its statistics so we should never see it
+                REQUIRE(stats.identifier[0] != "Quiet Handler");
+            });
+
+            on<Trigger<Counted>>().then("Counted Handler", [this] {
+                ++countedTasks;
+            });
+
+            on<Trigger<Counted>>().then("Quiet Handler", [this] {
+                ++quietTasks;
+            }).enableStatistics(false);
+
+            on<Startup>().then([this] {
+                for (int i = 0; i < 20; ++i) {
+                    emit<Scope::DIRECT>(std::make_unique<Counted>());
+                }
+                powerplant.shutdown();
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing reaction statistics sampling and per reaction disabling", "[api][reactionstatistics]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.statisticsSampleRate = 5;
+    NUClear::PowerPlant plant(config);
+
+    plant.install<SamplingReactor>();
+
+    plant.start();
+
+    REQUIRE(countedTasks == 20);
+    REQUIRE(quietTasks == 20);
+    REQUIRE(countedStats == 4);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <catch.hpp>
+
+#include "nuclear"
+
+namespace {
+
+    using NUClear::message::ChronoConfiguration;
+
+    ChronoConfiguration::Overrun policy;
+    bool align;
+
+    std::vector<NUClear::clock::time_point> times;
+    uint64_t overruns;
+    uint64_t skipped;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            emit<Scope::DIRECT>(std::make_unique<ChronoConfiguration>(std::chrono::microseconds(200), policy, align));
+
+            on<Every<10, std::chrono::seconds>>().then("Tick", [this] {
+
+                times.push_back(NUClear::clock::now());
+
+                // Stall on our third tick for long enough to miss three more
+                if (times.size() == 3) {
+                    NUClear::clock::advance(std::chrono::seconds(35));
+                }
+                else if (times.size() == 6) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Trigger<NUClear::message::EveryJitterSnapshot>>().then([] (const NUClear::message::EveryJitterSnapshot& snapshot) {
+                for (auto& every : snapshot.every) {
+                    if (every.identifier[0] == "Tick") {
+                        overruns += every.overruns;
+                        skipped += every.skipped;
+                    }
+                }
+            });
+        }
+    };
+
+    // Runs the ticks in fast forwarded virtual time, returning the time of each relative to the first in seconds
+    std::vector<int> run(ChronoConfiguration::Overrun p, bool a) {
+
+        policy = p;
+        align = a;
+        times.clear();
+        overruns = 0;
+        skipped = 0;
+
+        NUClear::PowerPlant::Configuration config;
+        config.threadCount = 1;
+        config.clockRate = 0.0;
+        config.fastForward = true;
+        NUClear::PowerPlant plant(config);
+        plant.install<TestReactor>();
+        plant.start();
+
+        std::vector<int> out;
+        for (size_t i = 0; i < 6 && i < times.size(); ++i) {
+            out.push_back(int(std::chrono::duration_cast<std::chrono::seconds>(times[i] - times.front()).count()));
+        }
+        return out;
+    }
+}
+
+TEST_CASE("Testing Every catches up missed ticks when it overruns", "[api][every][overrun]") {
+
+    REQUIRE(run(ChronoConfiguration::CATCH_UP, false) == std::vector<int>({0, 10, 20, 55, 55, 55}));
+}
+
+TEST_CASE("Testing Every skips missed ticks and stays aligned when it overruns", "[api][every][overrun]") {
+
+    REQUIRE(run(ChronoConfiguration::SKIP, true) == std::vector<int>({0, 10, 20, 55, 60, 70}));
+
+    // Aligned ticks start on a multiple of their period
+    for (size_t i : {0, 1, 2, 4, 5}) {
+        REQUIRE(times[i].time_since_epoch() % std::chrono::seconds(10) == NUClear::clock::duration(0));
+    }
+
+    // The stall was reported
+    REQUIRE(overruns == 1);
+    REQUIRE(skipped == 2);
+}
+
+TEST_CASE("Testing Every starts a new schedule when it overruns", "[api][every][overrun]") {
+
+    REQUIRE(run(ChronoConfiguration::REALIGN, false) == std::vector<int>({0, 10, 20, 55, 65, 75}));
+}
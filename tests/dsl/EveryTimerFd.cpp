@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include "nuclear"
+
+// Anonymous namespace to keep everything file local
+namespace {
+
+    std::vector<NUClear::clock::time_point> times;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Every<10, std::chrono::milliseconds>>().then([this] {
+                times.push_back(NUClear::clock::now());
+
+                if (times.size() == 50) {
+                    powerplant.shutdown();
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing Every reactions woken by a timerfd in the IO controller", "[api][every][timerfd]") {
+
+#ifdef __linux__
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.multiplexTimers = true;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    // Without busy waiting we can be late, but on average we should still keep to our period
+    // We skip the first few as they catch up on the time between installing the reactor and starting
+    REQUIRE(times.size() == 50);
+    double period = std::chrono::duration<double, std::milli>(times.back() - times[10]).count() / (times.size() - 11);
+    REQUIRE(period > 9.5);
+    REQUIRE(period < 10.5);
+#endif
+}
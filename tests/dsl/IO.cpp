@@ -77,6 +77,200 @@ namespace {
         int out;
         ReactionHandle writer;
     };
+
+    /// @brief counts every time the controller tries to make a task, as it is checked before IO's Single
+    struct CountAttempts {
+        static std::atomic<int> attempts;
+
+        template <typename DSL>
+        static inline bool precondition(NUClear::threading::Reaction&) {
+            ++attempts;
+            return true;
+        }
+    };
+    std::atomic<int> CountAttempts::attempts(0);
+
+    class RearmReactor : public NUClear::Reactor {
+    public:
+        RearmReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , in(0)
+            , out(0)
+            , reads(0) {
+
+            int fds[2];
+
+            if(pipe(fds) < 0) {
+                FAIL("We couldn't make the pipe for the test");
+            }
+
+            in = fds[0];
+            out = fds[1];
+
+            on<CountAttempts, IO>(in, IO::READ).then([this] (const IO::Event& e) {
+
+                // Give the controller a chance to see that there is still more to read while we are running
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                // Only read one byte so the pipe is still readable when we finish
+                unsigned char val;
+                ssize_t bytes = ::read(e.fd, &val, 1);
+                REQUIRE(bytes == 1);
+                REQUIRE(val == reads);
+
+                // We should be run again for each byte
+                if(++reads == 3) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this] {
+                unsigned char vals[] = { 0, 1, 2 };
+                REQUIRE(::write(out, vals, sizeof(vals)) == sizeof(vals));
+            });
+        }
+
+        int in;
+        int out;
+        int reads;
+    };
+
+    class ReceiveReactor : public NUClear::Reactor {
+    public:
+        ReceiveReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , in(0)
+            , out(0) {
+
+            int fds[2];
+
+            if(pipe(fds) < 0) {
+                FAIL("We couldn't make the pipe for the test");
+            }
+
+            in = fds[0];
+            out = fds[1];
+
+            on<IO::Receive>(in).then([this] (const IO::Received& r) {
+
+                REQUIRE(r.fd == in);
+
+                // Once we have our data close our end, the next read will find the end of the file
+                if(r.data.size() > 0) {
+                    REQUIRE(std::string(r.data.begin(), r.data.end()) == "hello");
+
+                    // The buffer was sized for what was waiting rather than being the biggest the pool has
+                    REQUIRE(r.data.capacity() == NUClear::util::BufferPool::MIN_BLOCK_SIZE);
+                    ::close(out);
+                }
+                else {
+                    REQUIRE((r.events & IO::CLOSE) != 0);
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this] {
+                REQUIRE(::write(out, "hello", 5) == 5);
+            });
+        }
+
+        int in;
+        int out;
+    };
+
+    constexpr int BATCH_PIPES = 4;
+    int batchTasks = 0;
+    int batchReads = 0;
+
+    class BatchReactor : public NUClear::Reactor {
+    public:
+        BatchReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , ins()
+            , outs() {
+
+            for(int i = 0; i < BATCH_PIPES; ++i) {
+                int fds[2];
+
+                if(pipe(fds) < 0) {
+                    FAIL("We couldn't make the pipe for the test");
+                }
+
+                ins.push_back(fds[0]);
+                outs.push_back(fds[1]);
+            }
+
+            on<IO::Batch>(ins, IO::READ).then([this] (const IO::Events& events) {
+                ++batchTasks;
+
+                for(auto& e : events) {
+                    REQUIRE((e.events & IO::READ) != 0);
+
+                    unsigned char val;
+                    ssize_t bytes = ::read(e.fd, &val, 1);
+                    REQUIRE(bytes == 1);
+                    REQUIRE(val == 0xDE);
+                    ++batchReads;
+                }
+
+                if(batchReads == BATCH_PIPES) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this] {
+                // Make all of the pipes ready before the controller gets to look at them
+                for(auto& out : outs) {
+                    unsigned char val = 0xDE;
+                    REQUIRE(::write(out, &val, 1) == 1);
+                }
+            });
+        }
+
+        std::vector<int> ins;
+        std::vector<int> outs;
+    };
+
+    // More than the 256 entries of the io_uring submission queue
+    constexpr int MANY_PIPES = 300;
+    int manyReads = 0;
+
+    class ManyReactor : public NUClear::Reactor {
+    public:
+        ManyReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , outs() {
+
+            for(int i = 0; i < MANY_PIPES; ++i) {
+                int fds[2];
+
+                if(pipe(fds) < 0) {
+                    FAIL("We couldn't make the pipe for the test");
+                }
+
+                outs.push_back(fds[1]);
+
+                on<IO>(fds[0], IO::READ).then([this] (const IO::Event& e) {
+                    unsigned char val;
+                    REQUIRE(::read(e.fd, &val, 1) == 1);
+                    REQUIRE(val == 0xDE);
+
+                    if(++manyReads == MANY_PIPES) {
+                        powerplant.shutdown();
+                    }
+                });
+            }
+
+            on<Startup>().then([this] {
+                for(auto& out : outs) {
+                    unsigned char val = 0xDE;
+                    REQUIRE(::write(out, &val, 1) == 1);
+                }
+            });
+        }
+
+        std::vector<int> outs;
+    };
 }
 
 TEST_CASE("Testing the IO extension", "[api][io]") {
@@ -89,4 +283,102 @@ TEST_CASE("Testing the IO extension", "[api][io]") {
     plant.start();
 }
 
+TEST_CASE("Testing the IO extension using io_uring", "[api][io][io_uring]") {
+
+    // If io_uring isn't available this falls back to epoll and should act the same
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.ioUring = true;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+}
+
+TEST_CASE("Testing IO reactions are watched again when their task finishes", "[api][io][rearm]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 2;
+
+    SECTION("Using the default poller") {
+    }
+    SECTION("Using io_uring") {
+        config.ioUring = true;
+    }
+
+    CountAttempts::attempts = 0;
+
+    NUClear::PowerPlant plant(config);
+    plant.install<RearmReactor>();
+
+    plant.start();
+
+    // We are only watched again once our task has finished, so the controller never tries while it is running
+    REQUIRE(CountAttempts::attempts == 3);
+}
+
+TEST_CASE("Testing IO batches get the events of many file descriptors in one task", "[api][io][batch]") {
+
+    batchTasks = 0;
+    batchReads = 0;
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+
+    SECTION("Using the default poller") {
+    }
+    SECTION("Using io_uring") {
+        config.ioUring = true;
+    }
+    SECTION("Using multiple IO threads") {
+        config.ioThreads = 2;
+    }
+
+    NUClear::PowerPlant plant(config);
+    plant.install<BatchReactor>();
+
+    plant.start();
+
+    // The writes all happen at startup so the controller should see most of them together
+    REQUIRE(batchReads == BATCH_PIPES);
+    REQUIRE(batchTasks < BATCH_PIPES);
+}
+
+TEST_CASE("Testing io_uring watches more file descriptors than fit in its submission queue", "[api][io][io_uring]") {
+
+    manyReads = 0;
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.ioUring = true;
+    NUClear::PowerPlant plant(config);
+    plant.install<ManyReactor>();
+
+    plant.start();
+
+    REQUIRE(manyReads == MANY_PIPES);
+}
+
+TEST_CASE("Testing IO receive reads the data into buffers from the pool", "[api][io][receive]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<ReceiveReactor>();
+
+    plant.start();
+}
+
+TEST_CASE("Testing the IO extension with multiple IO threads", "[api][io][io_threads]") {
+
+    // The two ends of the pipe have consecutive numbers so they are watched by different IO threads
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    config.ioThreads = 2;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+}
+
 #endif
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <catch.hpp>
+
+// Windows can't do this test as it doesn't have file descriptors
+#ifndef _WIN32
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "nuclear"
+
+namespace {
+
+    constexpr int NUM_EVENTS = 20000;
+
+    size_t idleCount;
+    NUClear::clock::duration elapsed;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+        TestReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , fds()
+            , count(0)
+            , start() {
+
+            // Watch a lot of pipes that never do anything
+            for (size_t i = 0; i < idleCount + 1; ++i) {
+                int p[2];
+                if(pipe(p) < 0) {
+                    FAIL("We couldn't make the pipes for the test");
+                }
+                fds.push_back(p[0]);
+                fds.push_back(p[1]);
+
+                if (i < idleCount) {
+                    on<IO>(p[0], IO::READ).then([] {});
+                }
+            }
+
+            // Bounce a byte through the last pipe, each bounce is a single IO event
+            int in = fds[fds.size() - 2];
+            int out = fds.back();
+
+            on<IO>(in, IO::READ).then([this, out] (const IO::Event& e) {
+
+                char val;
+                if (::read(e.fd, &val, 1) != 1) {
+                    return;
+                }
+
+                if (++count == NUM_EVENTS) {
+                    elapsed = NUClear::clock::now() - start;
+                    powerplant.shutdown();
+                }
+                else if (::write(out, &val, 1) != 1) {
+                    FAIL("We couldn't write to the pipe");
+                }
+            });
+
+            on<Startup>().then([this, out] {
+                start = NUClear::clock::now();
+                char val = 0;
+                if (::write(out, &val, 1) != 1) {
+                    FAIL("We couldn't write to the pipe");
+                }
+            });
+        }
+
+        ~TestReactor() {
+            for (int fd : fds) {
+                ::close(fd);
+            }
+        }
+
+        std::vector<int> fds;
+        int count;
+        NUClear::clock::time_point start;
+    };
+
+    constexpr int NUM_PAIRS    = 64;
+    constexpr int NUM_MESSAGES = 100000;
+
+    std::atomic<int> received;
+
+    class LoopbackReactor : public NUClear::Reactor {
+    public:
+        LoopbackReactor(std::unique_ptr<NUClear::Environment> environment)
+            : Reactor(std::move(environment))
+            , fds()
+            , start() {
+
+            // Make pairs of UDP sockets on loopback that are connected to each other
+            for (int i = 0; i < NUM_PAIRS; ++i) {
+                int a = socket(AF_INET, SOCK_DGRAM, 0);
+                int b = socket(AF_INET, SOCK_DGRAM, 0);
+                fds.push_back(a);
+                fds.push_back(b);
+
+                sockaddr_in addrA = bind(a);
+                sockaddr_in addrB = bind(b);
+                if (connect(a, reinterpret_cast<sockaddr*>(&addrB), sizeof(addrB)) < 0
+                    || connect(b, reinterpret_cast<sockaddr*>(&addrA), sizeof(addrA)) < 0) {
+                    FAIL("We couldn't connect the sockets for the test");
+                }
+
+                // Bounce a message back and forth between each pair
+                for (int fd : {a, b}) {
+                    on<IO>(fd, IO::READ).then([this] (const IO::Event& e) {
+
+                        char val;
+                        if (::recv(e.fd, &val, 1, MSG_DONTWAIT) != 1) {
+                            return;
+                        }
+
+                        int count = ++received;
+                        if (count == NUM_MESSAGES) {
+                            elapsed = NUClear::clock::now() - start;
+                            powerplant.shutdown();
+                        }
+                        else if (count < NUM_MESSAGES && ::send(e.fd, &val, 1, 0) != 1) {
+                            FAIL("We couldn't send on the socket");
+                        }
+                    });
+                }
+            }
+
+            on<Startup>().then([this] {
+                start = NUClear::clock::now();
+                char val = 0;
+                for (size_t i = 0; i < fds.size(); i += 2) {
+                    if (::send(fds[i], &val, 1, 0) != 1) {
+                        FAIL("We couldn't send on the socket");
+                    }
+                }
+            });
+        }
+
+        ~LoopbackReactor() {
+            for (int fd : fds) {
+                ::close(fd);
+            }
+        }
+
+        static sockaddr_in bind(int fd) {
+            sockaddr_in addr {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+
+            socklen_t len = sizeof(addr);
+            if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0
+                || getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+                FAIL("We couldn't bind the sockets for the test");
+            }
+            return addr;
+        }
+
+        std::vector<int> fds;
+        NUClear::clock::time_point start;
+    };
+
+    // Gets the number of messages per second bounced between loopback sockets
+    double loopbackThroughput(bool ioUring) {
+
+        received = 0;
+
+        NUClear::PowerPlant::Configuration config;
+        config.threadCount = 1;
+        config.ioUring = ioUring;
+        NUClear::PowerPlant plant(config);
+        plant.install<LoopbackReactor>();
+        plant.start();
+
+        return double(NUM_MESSAGES) / std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+    }
+
+    // Gets the average time for an IO event in nanoseconds when there are this many other file descriptors watched
+    double timePerEvent(size_t idle) {
+
+        idleCount = idle;
+
+        NUClear::PowerPlant::Configuration config;
+        config.threadCount = 1;
+        NUClear::PowerPlant plant(config);
+        plant.install<TestReactor>();
+        plant.start();
+
+        return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / NUM_EVENTS;
+    }
+
+    constexpr int NUM_DATAGRAMS = 20000;
+    constexpr int DATAGRAM_BATCH = 64;
+
+    // Gets the number of datagrams per second that are sent to a loopback socket, the way our emits used to (a new
+    // socket for each datagram), with an emit for each datagram, or with batch emits
+    std::tuple<double, double, double> sendThroughput() {
+
+        // Somewhere for the datagrams to go, we never read it so most of them are dropped
+        int sink = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in target = LoopbackReactor::bind(sink);
+        in_port_t port = ntohs(target.sin_port);
+
+        auto rate = [] (NUClear::clock::duration d) {
+            return double(NUM_DATAGRAMS) / std::chrono::duration_cast<std::chrono::duration<double>>(d).count();
+        };
+
+        auto start = NUClear::clock::now();
+        for (int i = 0; i < NUM_DATAGRAMS; ++i) {
+            int fd = socket(AF_INET, SOCK_DGRAM, 0);
+            int yes = true;
+            setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &yes, sizeof(yes));
+            sendto(fd, &i, sizeof(i), 0, reinterpret_cast<sockaddr*>(&target), sizeof(target));
+            ::close(fd);
+        }
+        double fresh = rate(NUClear::clock::now() - start);
+
+        NUClear::PowerPlant::Configuration config;
+        config.threadCount = 1;
+        NUClear::PowerPlant plant(config);
+
+        start = NUClear::clock::now();
+        for (int i = 0; i < NUM_DATAGRAMS; ++i) {
+            plant.emit<NUClear::dsl::word::emit::UDP>(std::make_unique<int>(i), INADDR_LOOPBACK, port);
+        }
+        double single = rate(NUClear::clock::now() - start);
+
+        start = NUClear::clock::now();
+        for (int i = 0; i < NUM_DATAGRAMS; i += DATAGRAM_BATCH) {
+            std::vector<std::unique_ptr<int>> batch;
+            for (int j = 0; j < DATAGRAM_BATCH; ++j) {
+                batch.push_back(std::make_unique<int>(i + j));
+            }
+            plant.emit<NUClear::dsl::word::emit::UDP>(std::move(batch), INADDR_LOOPBACK, port);
+        }
+        double batched = rate(NUClear::clock::now() - start);
+
+        ::close(sink);
+
+        return std::make_tuple(fresh, single, batched);
+    }
+}
+
+TEST_CASE("Benchmarking how the cost of an IO event grows with the number of watched file descriptors", "[.][benchmark][io]") {
+
+    double few  = timePerEvent(10);
+    double many = timePerEvent(2000);
+
+    WARN("Per event cost with 10 idle file descriptors: " << few << "ns, with 2000: " << many << "ns");
+
+    // The cost of an event should not depend on how many file descriptors are being watched
+    REQUIRE(many < few * 2);
+}
+
+TEST_CASE("Benchmarking the throughput of IO events on loopback sockets with epoll and io_uring", "[.][benchmark][io][io_uring]") {
+
+    double epoll = loopbackThroughput(false);
+    double uring = loopbackThroughput(true);
+
+    WARN("Messages per second on " << NUM_PAIRS << " loopback socket pairs, epoll: " << epoll << ", io_uring: " << uring);
+
+    REQUIRE(epoll > 0);
+    REQUIRE(uring > 0);
+}
+
+TEST_CASE("Benchmarking sending UDP datagrams on loopback with shared sockets and batch emits", "[.][benchmark][udp]") {
+
+    double fresh, single, batched;
+    std::tie(fresh, single, batched) = sendThroughput();
+
+    WARN("Datagrams per second with a new socket for each: " << fresh << ", with an emit for each: " << single
+         << ", with batch emits of " << DATAGRAM_BATCH << ": " << batched);
+
+    // Reusing the socket saves making and closing one for every datagram
+    REQUIRE(single > fresh);
+    REQUIRE(batched > 0);
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <catch.hpp>
+
+#include "nuclear"
+
+namespace {
+
+    std::atomic<int> runCount(0);
+    NUClear::threading::ReactionHandle handle;
+
+    struct SimpleMessage {};
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            // Five per second, so a token every 200ms
+            handle = on<Trigger<SimpleMessage>, Throttle<5, std::chrono::seconds>>().then([] {
+                ++runCount;
+            });
+
+            on<Startup>().then([this] {
+
+                // A burst of ten, only the first five have tokens
+                for (int i = 0; i < 10; ++i) {
+                    emit(std::make_unique<SimpleMessage>());
+                }
+
+                // Enough time for two more tokens
+                NUClear::clock::advance(std::chrono::milliseconds(400));
+
+                for (int i = 0; i < 10; ++i) {
+                    emit(std::make_unique<SimpleMessage>());
+                }
+
+                // We are finished the test
+                powerplant.shutdown();
+            });
+        }
+    };
+}
+
+TEST_CASE("Test that throttle limits how often a reaction runs and counts what it ignores", "[api][precondition][throttle]") {
+
+    // Stop the clock so only we move it
+    NUClear::clock::set(NUClear::clock::time_point(std::chrono::hours(1)), 0.0);
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    NUClear::clock::reset();
+
+    REQUIRE(runCount == 7);
+    REQUIRE(handle.throttled() == 13);
+
+    // Histogram snapshots only count what was throttled since the last one
+    auto throttledIn = [] (const NUClear::message::ReactionHistogramSnapshot& snapshot) {
+        uint64_t count = 0;
+        for (auto& reaction : snapshot.reactions) {
+            count += reaction.throttled;
+        }
+        return count;
+    };
+    NUClear::message::ReactionHistogramSnapshot first;
+    NUClear::threading::Reaction::snapshotHistograms(first);
+    REQUIRE(throttledIn(first) == 13);
+
+    NUClear::message::ReactionHistogramSnapshot second;
+    NUClear::threading::Reaction::snapshotHistograms(second);
+    REQUIRE(throttledIn(second) == 0);
+    REQUIRE(handle.throttled() == 13);
+}
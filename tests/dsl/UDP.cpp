@@ -16,6 +16,9 @@
  */
 
 #include <catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "nuclear"
 
@@ -97,3 +100,213 @@ TEST_CASE("Testing sending and receiving of UDP messages", "[api][network][udp]"
 
     plant.start();
 }
+
+namespace {
+
+    constexpr int burstSize = 100;
+    std::vector<int> burstReceived;
+
+    // A packet we keep hold of while the rest are read
+    NUClear::util::BufferPool::Buffer heldData;
+    int heldValue = -1;
+
+    class BurstReactor : public NUClear::Reactor {
+    public:
+        BurstReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            in_port_t boundPort;
+            std::tie(std::ignore, boundPort, std::ignore) = on<UDP>().then([this](const UDP::Packet& packet) {
+
+                // Every packet should know where it was sent to
+                REQUIRE(packet.remote.address == INADDR_LOOPBACK);
+                REQUIRE(packet.local.address == INADDR_LOOPBACK);
+                REQUIRE(packet.data.size() == sizeof(int));
+
+                int value;
+                std::memcpy(&value, packet.data.data(), sizeof(int));
+                burstReceived.push_back(value);
+
+                if(!heldData) {
+                    heldData = packet.data;
+                    heldValue = value;
+                }
+
+                if(burstReceived.size() == burstSize) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this, boundPort] {
+
+                // Send them all at once so they are waiting on the socket together
+                for(int i = 0; i < burstSize; ++i) {
+                    emit<Scope::UDP>(std::make_unique<int>(i), INADDR_LOOPBACK, boundPort);
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing receiving a burst of UDP messages", "[api][network][udp]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<BurstReactor>();
+
+    plant.start();
+
+    // They all arrive exactly once
+    REQUIRE(burstReceived.size() == burstSize);
+    std::sort(burstReceived.begin(), burstReceived.end());
+    for(int i = 0; i < burstSize; ++i) {
+        REQUIRE(burstReceived[i] == i);
+    }
+
+    // The buffer of the packet we held onto wasn't read into again
+    int value;
+    REQUIRE(heldData.size() == sizeof(int));
+    std::memcpy(&value, heldData.data(), sizeof(int));
+    REQUIRE(value == heldValue);
+    heldData = NUClear::util::BufferPool::Buffer();
+}
+
+#ifdef __linux__
+namespace {
+
+    constexpr int segmentCount = 10;
+    constexpr size_t segmentSize = 100;
+    std::vector<int> segmentsReceived;
+
+    class GROReactor : public NUClear::Reactor {
+    public:
+        GROReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            in_port_t boundPort;
+            NUClear::fd_t fd;
+            std::tie(std::ignore, boundPort, fd) = on<UDP>().then([this](const UDP::Packet& packet) {
+
+                // However they were received each packet comes out on its own
+                REQUIRE(packet.data.size() == segmentSize);
+
+                int value;
+                std::memcpy(&value, packet.data.data(), sizeof(int));
+                segmentsReceived.push_back(value);
+
+                if(segmentsReceived.size() == segmentCount) {
+                    powerplant.shutdown();
+                }
+            });
+
+            // It's fine if the kernel can't join them together, they will just arrive separately
+            UDP::enableGRO(fd);
+
+            on<Startup>().then([boundPort] {
+
+                std::vector<char> data(segmentCount * segmentSize);
+                for(int i = 0; i < segmentCount; ++i) {
+                    std::memcpy(data.data() + i * segmentSize, &i, sizeof(int));
+                }
+
+                sockaddr_in target;
+                std::memset(&target, 0, sizeof(sockaddr_in));
+                target.sin_family = AF_INET;
+                target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                target.sin_port = htons(boundPort);
+
+                int out = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+                // Have the kernel split one send into all our packets, or send them ourselves if it can't
+                int segment = segmentSize;
+                if(::setsockopt(out, SOL_UDP, UDP_SEGMENT, &segment, sizeof(segment)) == 0) {
+                    REQUIRE(::sendto(out, data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&target), sizeof(target)) == ssize_t(data.size()));
+                }
+                else {
+                    for(int i = 0; i < segmentCount; ++i) {
+                        ::sendto(out, data.data() + i * segmentSize, segmentSize, 0, reinterpret_cast<sockaddr*>(&target), sizeof(target));
+                    }
+                }
+
+                ::close(out);
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing receiving UDP packets that the kernel joined together", "[api][network][udp]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<GROReactor>();
+
+    plant.start();
+
+    REQUIRE(segmentsReceived.size() == segmentCount);
+    std::sort(segmentsReceived.begin(), segmentsReceived.end());
+    for(int i = 0; i < segmentCount; ++i) {
+        REQUIRE(segmentsReceived[i] == i);
+    }
+}
+#endif
+
+namespace {
+
+    constexpr int singleCount = 10;
+    std::atomic<int> singleReceived(0);
+    std::atomic<int> otherReceived(0);
+    int ticks = 0;
+
+    class SingleReactor : public NUClear::Reactor {
+    public:
+        SingleReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            // This can only take one packet at a time so the rest have to wait until it is done
+            in_port_t singlePort;
+            std::tie(std::ignore, singlePort, std::ignore) = on<UDP, Single>().then([this](const UDP::Packet&) {
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                if(++singleReceived == singleCount && otherReceived == 1) {
+                    powerplant.shutdown();
+                }
+            });
+
+            // Another socket being ready on the same thread shouldn't lose the waiting packets
+            in_port_t otherPort;
+            std::tie(std::ignore, otherPort, std::ignore) = on<UDP>().then([this](const UDP::Packet&) {
+
+                if(++otherReceived == 1 && singleReceived == singleCount) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this, singlePort, otherPort] {
+
+                for(int i = 0; i < singleCount; ++i) {
+                    emit<Scope::UDP>(std::make_unique<int>(i), INADDR_LOOPBACK, singlePort);
+                }
+                emit<Scope::UDP>(std::make_unique<int>(0), INADDR_LOOPBACK, otherPort);
+            });
+
+            // Give up if packets went missing rather than waiting forever
+            on<Every<1, std::chrono::seconds>>().then([this] {
+                if(++ticks == 5) {
+                    powerplant.shutdown();
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing UDP packets wait for a Single reaction to finish", "[api][network][udp]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<SingleReactor>();
+
+    plant.start();
+
+    REQUIRE(singleReceived == singleCount);
+    REQUIRE(otherReceived == 1);
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "nuclear"
+
+namespace {
+
+    struct IMU {
+        IMU(NUClear::clock::time_point timestamp, int value) : timestamp(timestamp), value(value) {}
+
+        NUClear::clock::time_point timestamp;
+        int value;
+    };
+
+    struct Image {
+        Image(NUClear::clock::time_point timestamp) : timestamp(timestamp) {}
+
+        NUClear::clock::time_point timestamp;
+    };
+
+    struct Odometry {
+        Odometry(NUClear::clock::time_point timestamp, int value) : timestamp(timestamp), value(value) {}
+
+        NUClear::clock::time_point timestamp;
+        int value;
+    };
+}
+
+namespace NUClear {
+    namespace dsl {
+        namespace trait {
+
+            template <>
+            struct timestamp<IMU> : public std::true_type {
+                static clock::time_point get(const IMU& imu) { return imu.timestamp; }
+            };
+
+            template <>
+            struct timestamp<Image> : public std::true_type {
+                static clock::time_point get(const Image& image) { return image.timestamp; }
+            };
+
+            template <>
+            struct timestamp<Odometry> : public std::true_type {
+                static constexpr size_t capacity = 4;
+                static clock::time_point get(const Odometry& odometry) { return odometry.timestamp; }
+            };
+        }
+    }
+}
+
+namespace {
+
+    const NUClear::clock::time_point epoch = NUClear::clock::now();
+
+    // The offset of each image and the IMU value that should be nearest to it
+    const std::map<int, int> expected = { { 23, 20 }, { 36, 40 }, { 51, 50 }, { 1000, 90 }, { -50, 0 } };
+    size_t received = 0;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<Image>, WithNearest<IMU, Image>>().then([this] (const Image& image, const IMU& imu) {
+
+                auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(image.timestamp - epoch).count();
+
+                REQUIRE(expected.count(offset) == 1);
+                REQUIRE(imu.value == expected.at(offset));
+
+                if(++received == expected.size()) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this] {
+
+                // IMU messages every 10ms, with a couple emitted out of order
+                for(int i : { 0, 10, 20, 30, 50, 40, 60, 70, 90, 80 }) {
+                    emit(std::make_unique<IMU>(epoch + std::chrono::milliseconds(i), i));
+                }
+
+                for(auto& e : expected) {
+                    emit(std::make_unique<Image>(epoch + std::chrono::milliseconds(e.first)));
+                }
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing getting the data nearest in time to the triggering data", "[api][withnearest]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    REQUIRE(received == expected.size());
+}
+
+TEST_CASE("Testing the TimeStore only keeps as many messages as its timestamp trait asks for", "[api][withnearest]") {
+
+    using Store = NUClear::dsl::store::TimeStore<Odometry>;
+    REQUIRE(Store::capacity == 4);
+    REQUIRE(NUClear::dsl::store::TimeStore<IMU>::capacity == 256);
+
+    // Each message's value is its offset from the epoch in milliseconds
+    auto at = [] (int ms) { return epoch + std::chrono::milliseconds(ms); };
+
+    REQUIRE(Store::nearest(at(0)) == nullptr);
+
+    for(int i = 0; i < 10; ++i) {
+        Store::insert(std::make_shared<Odometry>(at(i * 10), i * 10));
+    }
+
+    // Only the newest four are left
+    REQUIRE(Store::nearest(at(0))->value == 60);
+    REQUIRE(Store::nearest(at(74))->value == 70);
+    REQUIRE(Store::nearest(at(1000))->value == 90);
+
+    // Messages older than all of them are ignored
+    Store::insert(std::make_shared<Odometry>(at(5), 5));
+    REQUIRE(Store::nearest(at(0))->value == 60);
+
+    // Readers racing the writer always get a message that is still intact
+    std::atomic<bool> done(false);
+    std::atomic<int> bad(0);
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while(!done) {
+                auto odometry = Store::nearest(NUClear::clock::now());
+                if(!odometry || odometry->timestamp != at(odometry->value)) {
+                    ++bad;
+                }
+            }
+        });
+    }
+
+    for(int i = 10; i < 20000; ++i) {
+        Store::insert(std::make_shared<Odometry>(at(i * 10), i * 10));
+    }
+    done = true;
+    for(auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(bad == 0);
+    REQUIRE(Store::nearest(at(0))->value == 199960);
+}
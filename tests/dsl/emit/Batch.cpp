@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include "nuclear"
+
+namespace {
+
+    struct TestMessage {
+        int value;
+
+        TestMessage(int v) : value(v) {};
+    };
+
+    constexpr int BATCH_SIZE = 10;
+
+    int singleCounter = 0;
+    int batchCounter = 0;
+    bool seen[BATCH_SIZE] = {};
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<TestMessage>, With<TestMessage>>().then([this] (const TestMessage& m, const TestMessage& w) {
+
+                // Each element should be the one we get from a with, and we should only see it once
+                REQUIRE(m.value == w.value);
+                REQUIRE(!seen[m.value]);
+                seen[m.value] = true;
+                ++singleCounter;
+
+                if(singleCounter == BATCH_SIZE && batchCounter == 1) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Trigger<Batch<TestMessage>>>().then([this] (const Batch<TestMessage>& batch) {
+
+                // We should get every element in a single run
+                REQUIRE(batch.size() == BATCH_SIZE);
+                for(int i = 0; i < BATCH_SIZE; ++i) {
+                    REQUIRE(batch[i]->value == i);
+                }
+                ++batchCounter;
+
+                if(singleCounter == BATCH_SIZE && batchCounter == 1) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this] {
+
+                std::vector<std::unique_ptr<TestMessage>> batch;
+                for(int i = 0; i < BATCH_SIZE; ++i) {
+                    batch.push_back(std::make_unique<TestMessage>(i));
+                }
+
+                emit(std::move(batch));
+
+                // The store should only hold the last element of the batch
+                REQUIRE(NUClear::dsl::store::DataStore<TestMessage>::get()->value == BATCH_SIZE - 1);
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing emitting a batch of messages", "[api][emit][batch]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    REQUIRE(singleCounter == BATCH_SIZE);
+    REQUIRE(batchCounter == 1);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <cstdio>
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <unistd.h>
+#endif
+
+#include "nuclear"
+#include "nuclear_bits/extension/FileController.hpp"
+
+// Anonymous namespace to keep everything file local
+namespace {
+
+    const std::string path = "nuclear_file_emit_test.txt";
+    constexpr int WRITES = 100;
+
+    std::string expected;
+    size_t bytes = 0;
+    size_t writes = 0;
+    size_t reports = 0;
+    bool contentsRead = false;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<NUClear::message::FileWritten>>().then([this] (const NUClear::message::FileWritten& written) {
+                REQUIRE(written.path == path);
+                REQUIRE(written.error == 0);
+
+                bytes += written.bytes;
+                writes += written.writes;
+                ++reports;
+
+                // Once everything is written read it back
+                if(writes == WRITES) {
+                    on<FileRead>(path).then([this] (const FileRead::Contents& contents) {
+                        REQUIRE(contents.error == 0);
+                        REQUIRE(std::string(contents.data.begin(), contents.data.end()) == expected);
+                        contentsRead = true;
+
+                        powerplant.shutdown();
+                    });
+                }
+            });
+
+            on<Startup>().then([this] {
+                for(int i = 0; i < WRITES; ++i) {
+                    std::string line = "line " + std::to_string(i) + "\n";
+                    expected += line;
+
+                    // Sync with the last write
+                    emit<Scope::FILE>(std::make_unique<std::string>(line), path, i == WRITES - 1);
+                }
+            });
+        }
+    };
+
+#ifdef __linux__
+    const std::string manyPrefix = "nuclear_file_emit_many_";
+    constexpr int MANY_FILES = 100;
+
+    size_t manyReports = 0;
+    int openDuringRun = -1;
+
+    // Counts how many of our test files this process has open
+    int openTestFiles() {
+        int count = 0;
+        DIR* dir = opendir("/proc/self/fd");
+        while(dirent* entry = readdir(dir)) {
+            char target[4096];
+            ssize_t length = readlinkat(dirfd(dir), entry->d_name, target, sizeof(target) - 1);
+            if(length > 0) {
+                target[length] = 0;
+                if(std::string(target).find(manyPrefix) != std::string::npos) {
+                    ++count;
+                }
+            }
+        }
+        closedir(dir);
+        return count;
+    }
+
+    class ManyFilesReactor : public NUClear::Reactor {
+    public:
+        ManyFilesReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            on<Trigger<NUClear::message::FileWritten>>().then([this] (const NUClear::message::FileWritten& written) {
+                REQUIRE(written.error == 0);
+
+                // Once everything is written, a read is handled after the file thread has tidied up its files
+                if(++manyReports == MANY_FILES) {
+                    on<FileRead>(manyPrefix + "0.txt").then([this] (const FileRead::Contents& contents) {
+                        REQUIRE(contents.error == 0);
+                        openDuringRun = openTestFiles();
+                        powerplant.shutdown();
+                    });
+                }
+            });
+
+            on<Startup>().then([this] {
+                for(int i = 0; i < MANY_FILES; ++i) {
+                    emit<Scope::FILE>(std::make_unique<std::string>("data\n"), manyPrefix + std::to_string(i) + ".txt");
+                }
+            });
+        }
+    };
+#endif
+}
+
+TEST_CASE("Testing file emits are written in order and can be read back", "[api][emit][file]") {
+
+    std::remove(path.c_str());
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    plant.start();
+
+    REQUIRE(contentsRead);
+    REQUIRE(bytes == expected.size());
+
+    // The writes were queued together so they should have been reported together
+    REQUIRE(reports < WRITES);
+
+    std::remove(path.c_str());
+}
+
+#ifdef __linux__
+TEST_CASE("Testing file emits keep a bounded number of files open and close them at shutdown", "[api][emit][file]") {
+
+    manyReports = 0;
+    openDuringRun = -1;
+
+    {
+        NUClear::PowerPlant::Configuration config;
+        config.threadCount = 1;
+        NUClear::PowerPlant plant(config);
+        plant.install<ManyFilesReactor>();
+
+        plant.start();
+
+        // Only the most recently used files were kept open
+        REQUIRE(openDuringRun >= 0);
+        REQUIRE(size_t(openDuringRun) <= NUClear::extension::FileController::MAX_OPEN_FILES);
+
+        // Once the queued writes were done at shutdown everything was closed
+        REQUIRE(openTestFiles() == 0);
+    }
+
+    for(int i = 0; i < MANY_FILES; ++i) {
+        std::remove((manyPrefix + std::to_string(i) + ".txt").c_str());
+    }
+}
+#endif
@@ -79,3 +79,98 @@ TEST_CASE("Testing UDP emits work correctly", "[api][emit][udp]") {
 
     plant.start();
 }
+
+namespace {
+
+    constexpr int batchSize = 50;
+    int batchReceived = 0;
+
+    class BatchReactor : public NUClear::Reactor {
+    public:
+        BatchReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            in_port_t boundPort;
+            std::tie(std::ignore, boundPort, std::ignore) = on<UDP>().then([this] (const UDP::Packet& packet) {
+
+                REQUIRE(packet.remote.address == INADDR_LOOPBACK);
+                REQUIRE(packet.data.size() == sizeof(int));
+
+                if(++batchReceived == batchSize) {
+                    powerplant.shutdown();
+                }
+            });
+
+            on<Startup>().then([this, boundPort] {
+
+                // Send them all in one emit
+                std::vector<std::unique_ptr<int>> batch;
+                for(int i = 0; i < batchSize; ++i) {
+                    batch.push_back(std::make_unique<int>(i));
+                }
+                emit<Scope::UDP>(std::move(batch), INADDR_LOOPBACK, boundPort);
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing UDP batch emits work correctly", "[api][emit][udp]") {
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<BatchReactor>();
+
+    plant.start();
+
+    REQUIRE(batchReceived == batchSize);
+}
+
+namespace {
+
+    constexpr in_port_t fromPort = 40010;
+    bool fromReceived = false;
+    bool rebound = false;
+
+    class FromPortReactor : public NUClear::Reactor {
+    public:
+        FromPortReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            in_port_t boundPort;
+            std::tie(std::ignore, boundPort, std::ignore) = on<UDP>().then([this] (const UDP::Packet& packet) {
+
+                // The first one is sent from our port, once it's done the port can be listened on
+                if(!fromReceived) {
+                    REQUIRE(packet.remote.port == fromPort);
+                    fromReceived = true;
+
+                    try {
+                        on<UDP>(fromPort).then([this] {
+                            rebound = true;
+                            powerplant.shutdown();
+                        });
+                        emit<Scope::UDP>(std::make_unique<int>(1), INADDR_LOOPBACK, fromPort);
+                    }
+                    // The port is still in use
+                    catch(const std::system_error&) {
+                        powerplant.shutdown();
+                    }
+                }
+            });
+
+            on<Startup>().then([this, boundPort] {
+                emit<Scope::UDP>(std::make_unique<int>(0), INADDR_LOOPBACK, boundPort, INADDR_ANY, fromPort);
+            });
+        }
+    };
+}
+
+TEST_CASE("Testing UDP emits from a port don't keep it", "[api][emit][udp]") {
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<FromPortReactor>();
+
+    plant.start();
+
+    REQUIRE(fromReceived);
+    REQUIRE(rebound);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include "nuclear"
+#include "nuclear_bits/util/BufferPool.hpp"
+
+TEST_CASE("Testing the BufferPool reuses buffers once they are released", "[util][bufferpool]") {
+
+    using NUClear::util::BufferPool;
+
+    BufferPool pool(128);
+
+    const char* first;
+    {
+        BufferPool::Buffer a = pool.acquire();
+        REQUIRE(a);
+        REQUIRE(a.size() == 128);
+        REQUIRE(a.capacity() == 128);
+        first = a.data();
+
+        std::memcpy(a.data(), "hello", 5);
+        a.resize(5);
+        REQUIRE(std::string(a.begin(), a.end()) == "hello");
+
+        // Copies share the same buffer, it isn't released until they are all gone
+        BufferPool::Buffer b = a;
+        {
+            BufferPool::Buffer c = std::move(a);
+            REQUIRE(!a);
+            REQUIRE(c.data() == first);
+        }
+        REQUIRE(b.data() == first);
+        REQUIRE(b.size() == 5);
+
+        // While it is held a new buffer is needed
+        BufferPool::Buffer d = pool.acquire();
+        REQUIRE(d.data() != first);
+        REQUIRE(pool.allocated() == 2);
+    }
+
+    // Both buffers are back in the pool, so no more are made
+    std::vector<BufferPool::Buffer> buffers;
+    for(int i = 0; i < 2; ++i) {
+        buffers.push_back(pool.acquire());
+        REQUIRE(buffers.back().size() == 128);
+    }
+    REQUIRE(pool.allocated() == 2);
+    REQUIRE((buffers[0].data() == first || buffers[1].data() == first));
+
+    // Resizing is limited to the capacity
+    buffers[0].resize(1000);
+    REQUIRE(buffers[0].size() == 128);
+}
+
+TEST_CASE("Testing the BufferPool hands out the smallest buffer that fits", "[util][bufferpool]") {
+
+    using NUClear::util::BufferPool;
+
+    BufferPool pool(4096);
+
+    // Sizes are rounded up to a power of two, and limited to the block size
+    REQUIRE(pool.acquire(0).capacity() == BufferPool::MIN_BLOCK_SIZE);
+    REQUIRE(pool.acquire(100).capacity() == 256);
+    REQUIRE(pool.acquire(257).capacity() == 512);
+    REQUIRE(pool.acquire(4096).capacity() == 4096);
+    REQUIRE(pool.acquire(100000).capacity() == 4096);
+    REQUIRE(pool.acquire().capacity() == 4096);
+
+    // Each size is reused for the same size again
+    size_t allocated = pool.allocated();
+    const char* small;
+    {
+        BufferPool::Buffer a = pool.acquire(10);
+        small = a.data();
+    }
+    REQUIRE(pool.acquire(200).data() == small);
+    REQUIRE(pool.acquire(300).data() != small);
+    REQUIRE(pool.allocated() == allocated);
+
+    // A pool smaller than the smallest size only has one size
+    BufferPool tiny(64);
+    REQUIRE(tiny.acquire(10).capacity() == 64);
+    REQUIRE(tiny.acquire(1000).capacity() == 64);
+}
+
+TEST_CASE("Testing BufferPool buffers can be shared in parts", "[util][bufferpool]") {
+
+    using NUClear::util::BufferPool;
+
+    BufferPool pool(1024);
+
+    BufferPool::Buffer whole = pool.acquire(1024);
+    std::memcpy(whole.data(), "helloworld", 10);
+    REQUIRE(whole.unique());
+
+    {
+        // Parts share the data of the whole buffer
+        BufferPool::Buffer world = whole.slice(5, 5);
+        REQUIRE(world.data() == whole.data() + 5);
+        REQUIRE(std::string(world.begin(), world.end()) == "world");
+        REQUIRE(world.capacity() == 1019);
+        REQUIRE(!whole.unique());
+
+        // A part can't go past the end of the buffer
+        REQUIRE(whole.slice(1000, 100).size() == 24);
+        REQUIRE(whole.slice(2000, 10).size() == 0);
+
+        // The part keeps the buffer out of the pool once the whole is gone
+        const char* data = whole.data();
+        whole = BufferPool::Buffer();
+        REQUIRE(world.unique());
+        REQUIRE(pool.acquire(1024).data() != data);
+    }
+
+    // Once the part is gone the buffer goes back
+    REQUIRE(pool.allocated() == 2);
+    pool.acquire(1024);
+    REQUIRE(pool.allocated() == 2);
+}
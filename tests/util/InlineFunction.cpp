@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "nuclear"
+
+namespace {
+    // Allocations are only counted on a thread while it asks for them to be, otherwise this is the default operator new
+    thread_local bool counting = false;
+    thread_local int allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    if(counting) {
+        ++allocations;
+    }
+    if(void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    using TaskFunction = NUClear::threading::ReactionTask::TaskFunction;
+
+    struct Large {
+        char padding[256];
+    };
+
+    struct TriggerMessage {
+        int value;
+    };
+
+    struct WithMessage {
+        int value;
+    };
+
+    // A callback that counts how many times it has been copied, and how many of it there are
+    struct Callback {
+        Callback(int& result) : result(result) {
+            ++live;
+        }
+        Callback(const Callback& other) : result(other.result) {
+            ++copies;
+            ++live;
+        }
+        Callback(Callback&& other) noexcept : result(other.result) {
+            ++live;
+        }
+        ~Callback() {
+            --live;
+        }
+        Callback& operator=(const Callback&) = delete;
+
+        void operator()(const TriggerMessage& t, const WithMessage& w) const {
+            result += t.value + w.value;
+        }
+
+        int& result;
+        static int copies;
+        static int live;
+    };
+
+    int Callback::copies = 0;
+    int Callback::live = 0;
+
+    using DSL = NUClear::dsl::Parse<NUClear::dsl::word::Trigger<TriggerMessage>, NUClear::dsl::word::With<WithMessage>>;
+
+    int result = 0;
+    std::unique_ptr<NUClear::threading::Reaction> reaction;
+
+    class TestReactor : public NUClear::Reactor {
+    public:
+        TestReactor(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+            // Build the reaction the same way on<Trigger<TriggerMessage>, With<WithMessage>>() does
+            reaction = NUClear::util::generate_reaction<DSL, Trigger<TriggerMessage>>(*this, "", NUClear::util::CallbackGenerator<DSL, Callback>(Callback(result)));
+        }
+    };
+}
+
+TEST_CASE("Testing tasks for a Trigger and With reaction bind their data without copying and only allocate the task", "[util][inlinefunction]") {
+
+    NUClear::PowerPlant::Configuration config;
+    config.threadCount = 1;
+    NUClear::PowerPlant plant(config);
+    plant.install<TestReactor>();
+
+    auto t = std::make_shared<TriggerMessage>(TriggerMessage { 2 });
+    auto w = std::make_shared<WithMessage>(WithMessage { 3 });
+    NUClear::dsl::store::DataStore<TriggerMessage>::set(t);
+    NUClear::dsl::store::DataStore<WithMessage>::set(w);
+
+    // Load the data once so the thread's cache holds its references before we start counting
+    reaction->getTask();
+    long triggerUses = t.use_count();
+    long withUses = w.use_count();
+
+    Callback::copies = 0;
+    for(int i = 0; i < 10; ++i) {
+        counting = true;
+        allocations = 0;
+        auto task = reaction->getTask();
+        int made = allocations;
+        counting = false;
+        REQUIRE(task);
+
+        // Making the task only allocates the ReactionTask itself
+        REQUIRE(made == 1);
+
+        // The data bound callback fits inside the task so wrapping it did not allocate
+        REQUIRE(task->callback.stored_inline());
+
+        // The task shares this thread's cached reference to our data, so the data's own count isn't touched
+        REQUIRE(t.use_count() == triggerUses);
+        REQUIRE(w.use_count() == withUses);
+
+        // Running it doesn't allocate at all
+        counting = true;
+        allocations = 0;
+        task = task->run(std::move(task));
+        int ran = allocations;
+        counting = false;
+        REQUIRE(ran == 0);
+    }
+
+    // The user's callback was never copied into a task
+    REQUIRE(Callback::copies == 0);
+    REQUIRE(result == 50);
+
+    // Only the store and this thread's cache hold our data
+    REQUIRE(t.use_count() == triggerUses);
+    REQUIRE(w.use_count() == withUses);
+
+    // A task that is still waiting when its reaction goes away keeps the callback alive
+    auto task = reaction->getTask();
+    REQUIRE(Callback::live == 1);
+    reaction.reset();
+    REQUIRE(Callback::live == 1);
+    task.reset();
+    REQUIRE(Callback::live == 0);
+}
+
+TEST_CASE("Testing the InlineFunction falls back to the heap for large functions", "[util][inlinefunction]") {
+
+    auto a = std::make_shared<int>(5);
+    Large large;
+    large.padding[255] = 7;
+    int result = 0;
+    bool moved = false;
+
+    {
+        TaskFunction f([&result, a, large] (std::unique_ptr<NUClear::threading::ReactionTask>&& task) {
+            result = *a + large.padding[255];
+            return std::move(task);
+        });
+        REQUIRE_FALSE(f.stored_inline());
+
+        // Moving a heap stored function only moves the pointer
+        TaskFunction g(std::move(f));
+        moved = !f && g;
+        g(nullptr);
+    }
+
+    REQUIRE(moved);
+    REQUIRE(result == 12);
+    REQUIRE(a.use_count() == 1);
+
+    // An empty function is false
+    TaskFunction empty;
+    REQUIRE_FALSE(empty);
+    REQUIRE_FALSE(empty.stored_inline());
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <chrono>
+
+#include "nuclear"
+
+TEST_CASE("Testing the LatencyHistogram buckets values within its precision", "[util][latencyhistogram]") {
+
+    using NUClear::util::LatencyHistogram;
+
+    // Small values get their own bucket
+    for (uint64_t i = 0; i < LatencyHistogram::SUB_BUCKETS; ++i) {
+        REQUIRE(LatencyHistogram::index(i) == i);
+        REQUIRE(LatencyHistogram::highest(i) == i);
+    }
+
+    // Every value must land in a bucket whose range holds it and is within the precision
+    for (uint64_t value = 1; value < (uint64_t(1) << 39); value = value * 3 / 2 + 1) {
+        size_t i = LatencyHistogram::index(value);
+        REQUIRE(i < size_t(LatencyHistogram::BUCKETS));
+        REQUIRE(LatencyHistogram::highest(i) >= value);
+        REQUIRE((i == 0 || LatencyHistogram::highest(i - 1) < value));
+        REQUIRE(double(LatencyHistogram::highest(i) - value) <= double(value) / LatencyHistogram::SUB_BUCKETS);
+    }
+
+    // Huge values go in the last bucket
+    REQUIRE(LatencyHistogram::index(uint64_t(1) << 50) == size_t(LatencyHistogram::BUCKETS) - 1);
+}
+
+TEST_CASE("Testing the LatencyHistogram percentiles and reset", "[util][latencyhistogram]") {
+
+    NUClear::util::LatencyHistogram histogram;
+
+    // Record 1 to 1000 microseconds
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+
+    auto data = histogram.snapshot(true);
+    REQUIRE(data.count == 1000);
+    REQUIRE(data.max == 1000000);
+
+    auto near = [] (NUClear::clock::duration d, double us) {
+        double v = std::chrono::duration<double, std::micro>(d).count();
+        return v >= us && v <= us * 1.07;
+    };
+
+    REQUIRE(near(data.percentile(50), 500));
+    REQUIRE(near(data.percentile(99), 990));
+    REQUIRE(near(data.percentile(99.9), 999));
+    REQUIRE(near(data.percentile(100), 1000));
+    REQUIRE(near(data.mean(), 500));
+
+    // After a reset the histogram should be empty
+    auto empty = histogram.snapshot(false);
+    REQUIRE(empty.count == 0);
+    REQUIRE(empty.max == 0);
+    REQUIRE(empty.percentile(99) == NUClear::clock::duration(0));
+}
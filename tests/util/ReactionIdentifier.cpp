@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include "nuclear"
+
+namespace {
+    struct SomeType {};
+}
+
+TEST_CASE("Testing reaction identifiers are shared between copies", "[util][reactionidentifier]") {
+
+    NUClear::util::ReactionIdentifier identifier = NUClear::util::get_identifier<SomeType, int>("Label", "Reactor");
+    NUClear::util::ReactionIdentifier copy = identifier;
+
+    REQUIRE(identifier.size() == 4);
+    REQUIRE(identifier[0] == "Label");
+    REQUIRE(identifier[1] == "Reactor");
+    REQUIRE(identifier[2].find("SomeType") != std::string::npos);
+    REQUIRE(identifier[3] == "int");
+
+    // Copies refer to the same strings rather than copying them
+    REQUIRE(&copy.get() == &identifier.get());
+
+    // An empty identifier has no strings
+    NUClear::util::ReactionIdentifier empty;
+    REQUIRE(empty.size() == 0);
+}
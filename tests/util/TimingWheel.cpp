@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "nuclear"
+#include "nuclear_bits/util/TimingWheel.hpp"
+
+namespace {
+    struct TestTimer : public NUClear::util::TimingWheel::Timer {
+        bool expired = false;
+    };
+}
+
+TEST_CASE("Testing the TimingWheel expires timers at the right time", "[util][timingwheel]") {
+
+    using NUClear::clock;
+    using NUClear::util::TimingWheel;
+
+    // Use a small tick so that our timers cover every level and the overflow list
+    clock::time_point start = clock::now();
+    TimingWheel wheel(start, std::chrono::microseconds(1));
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int64_t> when(0, 60000000);
+    std::uniform_int_distribution<int64_t> step(0, 200000);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    std::vector<std::unique_ptr<TestTimer>> timers;
+    for (int i = 0; i < 2000; ++i) {
+        timers.push_back(std::make_unique<TestTimer>());
+        timers.back()->when = start + std::chrono::microseconds(when(rng));
+        wheel.insert(*timers.back());
+    }
+    REQUIRE(wheel.size() == 2000);
+
+    clock::time_point now = start;
+    while (!wheel.empty()) {
+
+        // Check the wheel knows when the next timer is
+        clock::time_point expected = clock::time_point::max();
+        for (auto& t : timers) {
+            if (TimingWheel::linked(*t)) {
+                expected = std::min(expected, t->when);
+            }
+        }
+        REQUIRE(wheel.next() == expected);
+
+        // Cancel some timers as we go
+        if (action(rng) == 0) {
+            for (auto& t : timers) {
+                if (TimingWheel::linked(*t)) {
+                    wheel.cancel(*t);
+                    break;
+                }
+            }
+        }
+
+        now += std::chrono::microseconds(step(rng));
+
+        wheel.expire(now, [&] (TimingWheel::Timer& timer) {
+            auto& t = static_cast<TestTimer&>(timer);
+            REQUIRE(!t.expired);
+            REQUIRE(t.when <= now);
+            t.expired = true;
+        });
+
+        // Everything due must have expired and nothing else
+        for (auto& t : timers) {
+            REQUIRE((t->when <= now || !t->expired));
+            REQUIRE((t->when > now || t->expired || !TimingWheel::linked(*t)));
+        }
+    }
+}
+
+TEST_CASE("Testing the TimingWheel can repeat and cancel timers", "[util][timingwheel]") {
+
+    using NUClear::clock;
+    using NUClear::util::TimingWheel;
+
+    clock::time_point start = clock::now();
+    TimingWheel wheel(start);
+
+    TestTimer a;
+    TestTimer b;
+    a.when = start + std::chrono::milliseconds(10);
+    b.when = start + std::chrono::milliseconds(15);
+    wheel.insert(a);
+    wheel.insert(b);
+
+    // Repeat a every 10ms by reinserting it when it expires
+    int fired = 0;
+    auto repeat = [&] (TimingWheel::Timer& timer) {
+        if (&timer == &a) {
+            ++fired;
+            a.when += std::chrono::milliseconds(10);
+            wheel.insert(a);
+        }
+    };
+
+    for (int i = 1; i <= 100; ++i) {
+        wheel.expire(start + std::chrono::milliseconds(i), repeat);
+    }
+    REQUIRE(fired == 10);
+    REQUIRE(!TimingWheel::linked(b));
+    REQUIRE(wheel.next() == start + std::chrono::milliseconds(110));
+
+    wheel.cancel(a);
+    REQUIRE(wheel.empty());
+    REQUIRE(wheel.next() == clock::time_point::max());
+
+    // Cancelling a timer that is not in the wheel does nothing
+    wheel.cancel(a);
+    REQUIRE(wheel.empty());
+}
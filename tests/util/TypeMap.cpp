@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2013-2016 Trent Houliston <trent@houliston.me>, Jake Woods <jake.f.woods@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "nuclear"
+
+namespace {
+
+    struct TestMessage {
+        int value;
+    };
+
+    // Counts how many of it currently exist so we can tell replaced values are freed
+    struct Counted {
+        Counted(int value) : value(value) {
+            ++live;
+        }
+        ~Counted() {
+            --live;
+        }
+        Counted(const Counted&) = delete;
+        Counted& operator=(const Counted&) = delete;
+
+        int value;
+        static std::atomic<int> live;
+    };
+
+    std::atomic<int> Counted::live(0);
+
+    // A plain mutex protected map, the simplest way to share a value between threads, to compare the TypeMap against
+    struct MutexMap {
+        static std::shared_ptr<TestMessage> data;
+        static std::mutex mutex;
+
+        static void set(std::shared_ptr<TestMessage> d) {
+            std::lock_guard<std::mutex> lock(mutex);
+            data = std::move(d);
+        }
+
+        static std::shared_ptr<TestMessage> get() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return data;
+        }
+    };
+
+    std::shared_ptr<TestMessage> MutexMap::data;
+    std::mutex MutexMap::mutex;
+
+    using LockFreeMap = NUClear::util::TypeMap<MutexMap, TestMessage, TestMessage>;
+
+    constexpr int READERS = 8;
+    constexpr int READS = 1000000;
+    constexpr int WRITES = 10000;
+
+    template <typename TMap>
+    std::chrono::nanoseconds contend() {
+
+        TMap::set(std::make_shared<TestMessage>(TestMessage { 0 }));
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+
+        // Lots of readers hammering the same value
+        for(int i = 0; i < READERS; ++i) {
+            threads.emplace_back([] {
+                volatile int sink = 0;
+                for(int j = 0; j < READS; ++j) {
+                    sink = TMap::get()->value;
+                }
+                (void)sink;
+            });
+        }
+
+        // And an occasional writer updating it
+        threads.emplace_back([] {
+            for(int j = 1; j <= WRITES; ++j) {
+                TMap::set(std::make_shared<TestMessage>(TestMessage { j }));
+            }
+        });
+
+        for(auto& thread : threads) {
+            thread.join();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        REQUIRE(TMap::get()->value == WRITES);
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    }
+}
+
+TEST_CASE("Testing the TypeMap version increases each time data is set", "[typemap]") {
+
+    using Map = NUClear::util::TypeMap<TestMessage, TestMessage, int>;
+
+    // Nothing has been stored yet
+    REQUIRE(Map::version() == 0);
+    REQUIRE(Map::get() == nullptr);
+
+    for(int i = 1; i <= 5; ++i) {
+        Map::set(std::make_shared<int>(i));
+        REQUIRE(Map::version() == uint64_t(i));
+        REQUIRE(*Map::get() == i);
+    }
+
+    // Setting the same value again is still a new version
+    Map::set(Map::get());
+    REQUIRE(Map::version() == 6);
+}
+
+TEST_CASE("Testing the TypeMap frees replaced values once the readers using them are finished", "[typemap]") {
+
+    using Map = NUClear::util::TypeMap<Counted, Counted, Counted>;
+
+    constexpr int THREADS = 4;
+    constexpr int VALUES  = 20000;
+
+    Map::set(std::make_shared<Counted>(0));
+
+    std::atomic<bool> running(true);
+    std::atomic<bool> ordered(true);
+    std::vector<std::thread> threads;
+
+    // Readers must always get a live value, and the values they see must never go backwards
+    for(int i = 0; i < THREADS; ++i) {
+        threads.emplace_back([&] {
+            int last = 0;
+            while(running) {
+                auto value = Map::get();
+                if(value->value < last) {
+                    ordered = false;
+                }
+                last = value->value;
+            }
+        });
+    }
+
+    for(int i = 1; i <= VALUES; ++i) {
+        Map::set(std::make_shared<Counted>(i));
+    }
+
+    running = false;
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(ordered);
+    REQUIRE(Map::get()->value == VALUES);
+
+    // Only the value that is currently stored is still alive
+    REQUIRE(Counted::live == 1);
+}
+
+TEST_CASE("Testing the TypeMap can be set from many threads at once", "[typemap]") {
+
+    struct Writers {};
+    using Map = NUClear::util::TypeMap<Writers, Counted, Counted>;
+
+    constexpr int THREADS = 4;
+    constexpr int VALUES  = 5000;
+
+    // Other maps of Counted may be holding a value already
+    int before = Counted::live;
+
+    std::atomic<bool> running(true);
+    std::atomic<bool> valid(true);
+    std::vector<std::thread> readers;
+    std::vector<std::thread> writers;
+
+    for(int i = 0; i < THREADS; ++i) {
+        readers.emplace_back([&] {
+            while(running) {
+                auto value = Map::get();
+                if(value && (value->value < 1 || value->value > THREADS * VALUES)) {
+                    valid = false;
+                }
+            }
+        });
+    }
+
+    // More writers and readers than there are buffers in the map
+    for(int i = 0; i < THREADS; ++i) {
+        writers.emplace_back([i] {
+            for(int j = 1; j <= VALUES; ++j) {
+                Map::set(std::make_shared<Counted>(i * VALUES + j));
+            }
+        });
+    }
+
+    for(auto& thread : writers) {
+        thread.join();
+    }
+    running = false;
+    for(auto& thread : readers) {
+        thread.join();
+    }
+
+    REQUIRE(valid);
+    REQUIRE(Map::version() == THREADS * VALUES);
+
+    // Only the value that is currently stored is still alive
+    REQUIRE(Counted::live == before + 1);
+}
+
+TEST_CASE("Benchmarking contended reads of the TypeMap against a mutex protected map", "[.][benchmark][typemap]") {
+
+    auto mutexTime = contend<MutexMap>();
+    auto lockFreeTime = contend<LockFreeMap>();
+
+    std::cout << "TypeMap contention (" << READERS << " readers x " << READS << " reads, " << WRITES << " writes)" << std::endl;
+    std::cout << "  mutex:     " << double(mutexTime.count()) / (READERS * READS) << " ns/read" << std::endl;
+    std::cout << "  lock free: " << double(lockFreeTime.count()) / (READERS * READS) << " ns/read" << std::endl;
+}